@@ -0,0 +1,139 @@
+#include "BindingGenerator.h"
+#include "SystemDependencyCollector.h"
+#include "Utils.h"
+#include "defines/DefineEvaluator.h"
+#include "ir/LocationManager.h"
+#include "visitor/ScalaFrontendActionFactory.h"
+#include <clang/Frontend/TextDiagnosticPrinter.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+
+int generateBindings(const clang::tooling::CompilationDatabase &compilations,
+                     const std::string &header, const BindingOptions &options,
+                     llvm::raw_ostream &out, llvm::raw_ostream &diagnostics,
+                     PreambleCache *preambleCache, OutputCache *outputCache) {
+    if (!options.shimsFile.empty()) {
+        /* only Scala code is cached */
+        outputCache = nullptr;
+    }
+
+    std::string cacheKey;
+    if (outputCache) {
+        std::vector<std::string> arguments;
+        for (const auto &command : compilations.getCompileCommands(header)) {
+            arguments.insert(arguments.end(), command.CommandLine.begin(),
+                             command.CommandLine.end());
+        }
+        cacheKey = outputCache->getKey(header, arguments, options);
+        std::string output;
+        std::string cachedDiagnostics;
+        if (outputCache->lookup(cacheKey, output, cachedDiagnostics)) {
+            diagnostics << cachedDiagnostics;
+            diagnostics.flush();
+            out << output;
+            out.flush();
+            return 0;
+        }
+    }
+
+    /* diagnostics are stored together with generated code, so they are
+     * printed again when the code is taken from the cache */
+    std::string runDiagnostics;
+    llvm::raw_string_ostream runDiagnosticsStream(runDiagnostics);
+    llvm::raw_ostream &headerDiagnostics =
+        outputCache ? runDiagnosticsStream : diagnostics;
+
+    clang::tooling::ClangTool tool(compilations, {header});
+
+    /* the pragma makes DefineEvaluator add declarations for macros
+     * after the last line of the header */
+    std::string source;
+    if (auto buffer = llvm::MemoryBuffer::getFile(header)) {
+        source = (*buffer)->getBuffer().str() + "\n" +
+                 DefineEvaluator::getPragma() + "\n";
+        /* the tool does not copy contents of virtual files */
+        tool.mapVirtualFile(clang::tooling::getAbsolutePath(header), source);
+    }
+
+    clang::TextDiagnosticPrinter diagnosticPrinter(
+        headerDiagnostics, new clang::DiagnosticOptions());
+    tool.setDiagnosticConsumer(&diagnosticPrinter);
+
+    std::string pchPath;
+    if (preambleCache) {
+        pchPath = preambleCache->getPreamble(compilations, header,
+                                             headerDiagnostics);
+        if (!pchPath.empty()) {
+            tool.appendArgumentsAdjuster(
+                clang::tooling::getInsertArgumentAdjuster(
+                    {"-include-pch", pchPath},
+                    clang::tooling::ArgumentInsertPosition::BEGIN));
+        }
+    }
+
+    std::string resolved = getRealPath(header.c_str());
+    LocationManager locationManager(resolved);
+
+    if (!options.bindingConfig.empty()) {
+        locationManager.loadConfig(options.bindingConfig);
+    }
+
+    IR ir(options.libName, options.linkName, options.objectName,
+          options.packageName, locationManager, headerDiagnostics);
+
+    std::shared_ptr<SystemDependencyCollector> dependencyCollector;
+    if (outputCache) {
+        dependencyCollector = std::make_shared<SystemDependencyCollector>();
+    }
+    ScalaFrontendActionFactory actionFactory(ir, options.lazyTypes,
+                                             !options.shimsFile.empty(),
+                                             dependencyCollector);
+    int result = tool.run(&actionFactory);
+
+    ir.generate(options.excludePrefix);
+    if (options.arenaStats) {
+        diagnostics << "Arena: " << ir.getArena().getBytesUsed()
+                    << " bytes used for " << header << "\n";
+        diagnostics.flush();
+    }
+    if (!options.shimsFile.empty() && result == 0) {
+        std::error_code ec;
+        llvm::raw_fd_ostream shims(options.shimsFile, ec,
+                                   llvm::sys::fs::F_Text);
+        if (ec) {
+            headerDiagnostics << "Error: Cannot write " << options.shimsFile
+                              << ": " << ec.message() << "\n";
+            headerDiagnostics.flush();
+            return -1;
+        }
+        /* the header is expected to be found in include path */
+        shims << ir.getShims(llvm::sys::path::filename(header));
+    }
+    if (outputCache && result == 0) {
+        std::string output;
+        llvm::raw_string_ostream s(output);
+        s << ir;
+        s.flush();
+
+        std::vector<std::string> dependencies =
+            dependencyCollector->getDependencies();
+        if (!pchPath.empty()) {
+            /* headers loaded from precompiled header are not seen by
+             * preprocessor callbacks */
+            dependencies.push_back(pchPath);
+        }
+        runDiagnosticsStream.flush();
+        outputCache->store(cacheKey, dependencies, output, runDiagnostics);
+        out << output;
+    } else {
+        out << ir;
+    }
+    out.flush();
+    if (outputCache) {
+        runDiagnosticsStream.flush();
+        diagnostics << runDiagnostics;
+        diagnostics.flush();
+    }
+    return result;
+}
@@ -0,0 +1,35 @@
+#ifndef SCALA_NATIVE_BINDGEN_BINDINGGENERATOR_H
+#define SCALA_NATIVE_BINDGEN_BINDINGGENERATOR_H
+
+#include "BindingOptions.h"
+#include "OutputCache.h"
+#include "PreambleCache.h"
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/Support/raw_ostream.h>
+#include <string>
+
+/**
+ * Runs clang on a single header and writes generated Scala code to out.
+ *
+ * Each call creates its own IR, LocationManager and TypeTranslator,
+ * therefore several headers may be processed concurrently.
+ *
+ * @param diagnostics stream for warnings and errors of clang and bindgen.
+ *                    Concurrent calls should use distinct streams
+ *
+ * @param preambleCache if not nullptr then system includes at the beginning
+ *                      of the header are loaded from precompiled header
+ * @param outputCache if not nullptr then generated code is taken from the
+ *                    cache when neither the header, the headers it includes
+ *                    nor the options were changed. The cache is not
+ *                    used when options.shimsFile is set
+ *
+ * @return clang tool exit code
+ */
+int generateBindings(const clang::tooling::CompilationDatabase &compilations,
+                     const std::string &header, const BindingOptions &options,
+                     llvm::raw_ostream &out, llvm::raw_ostream &diagnostics,
+                     PreambleCache *preambleCache = nullptr,
+                     OutputCache *outputCache = nullptr);
+
+#endif // SCALA_NATIVE_BINDGEN_BINDINGGENERATOR_H
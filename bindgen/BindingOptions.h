@@ -0,0 +1,26 @@
+#ifndef SCALA_NATIVE_BINDGEN_BINDINGOPTIONS_H
+#define SCALA_NATIVE_BINDGEN_BINDINGOPTIONS_H
+
+#include <string>
+
+/**
+ * Options that are shared by all headers processed by one
+ * bindgen invocation.
+ */
+struct BindingOptions {
+    std::string libName;
+    std::string linkName;
+    std::string objectName;
+    std::string packageName;
+    std::string excludePrefix;
+    std::string bindingConfig; // may be empty
+    /** translate types from included headers only when they are used */
+    bool lazyTypes = false;
+    /** print number of bytes allocated for intermediate representation */
+    bool arenaStats = false;
+    /** C file for wrappers of functions that do not have linkable symbol
+     * or pass structs by value. May be empty */
+    std::string shimsFile;
+};
+
+#endif // SCALA_NATIVE_BINDGEN_BINDINGOPTIONS_H
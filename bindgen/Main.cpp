@@ -1,7 +1,131 @@
-#include "defines/DefineFinderActionFactory.h"
-#include "ir/LocationManager.h"
-#include "visitor/ScalaFrontendActionFactory.h"
+#include "BindingGenerator.h"
+#include "Server.h"
+#include "Utils.h"
+#include <atomic>
 #include <clang/Tooling/CommonOptionsParser.h>
+#include <iostream>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/ThreadPool.h>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/**
+ * Generate Scala file of a single header in outputDirectory.
+ */
+static int generateHeader(
+    const clang::tooling::CompilationDatabase &compilations,
+    const std::string &header, BindingOptions options,
+    const std::string &outputDirectory, llvm::raw_ostream &diagnostics,
+    PreambleCache *preambleCache, OutputCache *outputCache) {
+    llvm::SmallString<128> outputPath(outputDirectory);
+    llvm::sys::path::append(outputPath, options.objectName + ".scala");
+
+    if (!options.shimsFile.empty()) {
+        /* shimsFile is a directory in batch mode */
+        llvm::SmallString<128> shimsPath(options.shimsFile);
+        llvm::sys::path::append(shimsPath, options.objectName + ".c");
+        options.shimsFile = shimsPath.str();
+    }
+
+    std::error_code ec;
+    llvm::raw_fd_ostream out(outputPath, ec, llvm::sys::fs::F_Text);
+    if (ec) {
+        diagnostics << "Error: Cannot write " << outputPath << ": "
+                    << ec.message() << "\n";
+        diagnostics.flush();
+        return -1;
+    }
+
+    return generateBindings(compilations, header, options, out, diagnostics,
+                            preambleCache, outputCache);
+}
+
+/**
+ * Generate one Scala file per header in outputDirectory.
+ *
+ * Headers are processed by a fixed-size pool of worker threads.
+ * Scala object of each binding is named after the header file.
+ * Diagnostics of a header are printed together when it is processed.
+ */
+static int
+generateBatch(const clang::tooling::CompilationDatabase &compilations,
+              const std::vector<std::string> &headers,
+              const BindingOptions &options,
+              const std::string &outputDirectory, unsigned jobs,
+              PreambleCache *preambleCache, OutputCache *outputCache) {
+    if (std::error_code ec =
+            llvm::sys::fs::create_directories(outputDirectory)) {
+        llvm::errs() << "Error: Cannot create output directory "
+                     << outputDirectory << ": " << ec.message() << "\n";
+        llvm::errs().flush();
+        return -1;
+    }
+    if (!options.shimsFile.empty()) {
+        if (std::error_code ec =
+                llvm::sys::fs::create_directories(options.shimsFile)) {
+            llvm::errs() << "Error: Cannot create shims directory "
+                         << options.shimsFile << ": " << ec.message() << "\n";
+            llvm::errs().flush();
+            return -1;
+        }
+    }
+
+    /* object name is also the name of output file */
+    std::vector<std::string> objectNames;
+    std::map<std::string, std::string> headersByObjectName;
+    for (const auto &header : headers) {
+        std::string objectName = toIdentifier(llvm::sys::path::stem(header));
+        if (objectName == "native") {
+            objectName = "nativeLib";
+        }
+        auto inserted = headersByObjectName.emplace(objectName, header);
+        if (!inserted.second) {
+            llvm::errs() << "Error: Bindings of " << inserted.first->second
+                         << " and " << header << " would be written to "
+                         << objectName << ".scala\n";
+            llvm::errs().flush();
+            return -1;
+        }
+        objectNames.push_back(objectName);
+    }
+
+    if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::atomic<int> result(0);
+    std::mutex diagnosticsMutex;
+    llvm::ThreadPool pool(jobs);
+    for (size_t i = 0; i < headers.size(); i++) {
+        const std::string &header = headers[i];
+        const std::string &objectName = objectNames[i];
+        pool.async([&compilations, &options, &outputDirectory, &result,
+                    &diagnosticsMutex, preambleCache, outputCache, header,
+                    objectName]() {
+            BindingOptions headerOptions = options;
+            headerOptions.objectName = objectName;
+
+            std::string diagnostics;
+            llvm::raw_string_ostream diagnosticsStream(diagnostics);
+            int headerResult = generateHeader(
+                compilations, header, headerOptions, outputDirectory,
+                diagnosticsStream, preambleCache, outputCache);
+            if (headerResult) {
+                result = headerResult;
+            }
+
+            diagnosticsStream.flush();
+            std::lock_guard<std::mutex> lock(diagnosticsMutex);
+            llvm::errs() << diagnostics;
+            llvm::errs().flush();
+        });
+    }
+    pool.wait();
+    return result;
+}
 
 int main(int argc, const char *argv[]) {
     llvm::cl::OptionCategory Category("Scala Native Binding Generator");
@@ -30,12 +154,95 @@ int main(int argc, const char *argv[]) {
         "binding-config", llvm::cl::cat(Category),
         llvm::cl::desc("Path to a config file that contains the information "
                        "about bindings that should be reused"));
-    clang::tooling::CommonOptionsParser op(argc, argv, Category);
-    clang::tooling::ClangTool Tool(op.getCompilations(),
-                                   op.getSourcePathList());
+    llvm::cl::opt<std::string> OutputDirectory(
+        "output-dir", llvm::cl::cat(Category),
+        llvm::cl::desc("Generate one Scala file per header in given "
+                       "directory.\nRequired when several headers are given"));
+    llvm::cl::opt<unsigned> Jobs(
+        "jobs", llvm::cl::cat(Category), llvm::cl::init(0),
+        llvm::cl::desc("Number of headers processed in parallel when "
+                       "--output-dir is used.\nDefaults to the number of "
+                       "CPUs"));
+    llvm::cl::opt<std::string> PreambleCacheDirectory(
+        "preamble-cache", llvm::cl::cat(Category),
+        llvm::cl::desc("Directory where precompiled system includes are "
+                       "stored and\nreused between runs"));
+    llvm::cl::opt<std::string> OutputCacheDirectory(
+        "output-cache", llvm::cl::cat(Category),
+        llvm::cl::desc("Directory where generated bindings are cached. "
+                       "Bindings are\nreused if neither headers nor options "
+                       "were changed"));
+    llvm::cl::opt<bool> LazyTypes(
+        "lazy-types", llvm::cl::cat(Category),
+        llvm::cl::desc("Translate types from included headers only when "
+                       "they are used\nby declarations of the main header"));
+    llvm::cl::opt<bool> ArenaStats(
+        "arena-stats", llvm::cl::cat(Category),
+        llvm::cl::desc("Print number of bytes allocated for intermediate "
+                       "representation of each header"));
+    llvm::cl::opt<std::string> CShims(
+        "c-shims", llvm::cl::cat(Category),
+        llvm::cl::desc("Write C wrappers of static inline functions and "
+                       "functions that\npass structs by value to given file. "
+                       "With --output-dir it is\na directory where a file "
+                       "is written per header"));
+    llvm::cl::opt<bool> Serve(
+        "serve", llvm::cl::cat(Category),
+        llvm::cl::desc("Read requests from standard input and write "
+                       "generated bindings\nto standard output, one JSON "
+                       "object per line"));
+    clang::tooling::CommonOptionsParser op(argc, argv, Category,
+                                           llvm::cl::ZeroOrMore);
+
+    std::unique_ptr<OutputCache> outputCache;
+    if (!OutputCacheDirectory.getValue().empty()) {
+        outputCache =
+            llvm::make_unique<OutputCache>(OutputCacheDirectory.getValue());
+    }
+
+    if (Serve.getValue()) {
+        std::string preambleCacheDirectory = PreambleCacheDirectory.getValue();
+        bool isTemporaryDirectory = preambleCacheDirectory.empty();
+        if (isTemporaryDirectory) {
+            llvm::SmallString<128> temporaryDirectory;
+            if (std::error_code ec = llvm::sys::fs::createUniqueDirectory(
+                    "scala-native-bindgen-preamble", temporaryDirectory)) {
+                llvm::errs() << "Error: Cannot create preamble cache "
+                                "directory: "
+                             << ec.message() << "\n";
+                llvm::errs().flush();
+                return -1;
+            }
+            preambleCacheDirectory = temporaryDirectory.str();
+        }
+        int result;
+        {
+            PreambleCache preambleCache(preambleCacheDirectory);
+            result = serve(std::cin, llvm::outs(), preambleCache,
+                           outputCache.get());
+        }
+        if (isTemporaryDirectory) {
+            /* precompiled includes are not reused by other sessions */
+            llvm::sys::fs::remove_directories(preambleCacheDirectory);
+        }
+        return result;
+    }
 
-    if (op.getSourcePathList().size() != 1) {
-        llvm::errs() << "Error: Only one file may be processed at a time.\n";
+    std::vector<std::string> headers = op.getSourcePathList();
+    if (headers.empty()) {
+        /* take headers from compilation database */
+        headers = op.getCompilations().getAllFiles();
+    }
+    if (headers.empty()) {
+        llvm::errs() << "Error: No header file is given.\n";
+        llvm::errs().flush();
+        return -1;
+    }
+
+    std::string outputDirectory = OutputDirectory.getValue();
+    if (headers.size() != 1 && outputDirectory.empty()) {
+        llvm::errs() << "Error: Only one file may be processed at a time "
+                        "unless --output-dir is specified.\n";
         llvm::errs().flush();
         return -1;
     }
@@ -63,27 +270,30 @@ int main(int argc, const char *argv[]) {
         objectName = "nativeLib";
     }
 
-    std::string resolved = getRealPath(op.getSourcePathList()[0].c_str());
-    LocationManager locationManager(resolved);
+    BindingOptions options;
+    options.libName = libName;
+    options.linkName = linkName;
+    options.objectName = objectName;
+    options.packageName = Package.getValue();
+    options.excludePrefix = ExcludePrefix.getValue();
+    options.bindingConfig = ReuseBindingsConfig.getValue();
+    options.lazyTypes = LazyTypes.getValue();
+    options.arenaStats = ArenaStats.getValue();
+    options.shimsFile = CShims.getValue();
 
-    auto reuseBindingsConfig = ReuseBindingsConfig.getValue();
-    if (!reuseBindingsConfig.empty()) {
-        locationManager.loadConfig(reuseBindingsConfig);
+    std::unique_ptr<PreambleCache> preambleCache;
+    if (!PreambleCacheDirectory.getValue().empty()) {
+        preambleCache = llvm::make_unique<PreambleCache>(
+            PreambleCacheDirectory.getValue());
     }
 
-    IR ir(libName, linkName, objectName, Package.getValue(), locationManager);
-
-    DefineFinderActionFactory defineFinderActionFactory(ir);
-    int result = Tool.run(&defineFinderActionFactory);
-    if (result) {
-        return result;
+    if (!outputDirectory.empty()) {
+        return generateBatch(op.getCompilations(), headers, options,
+                             outputDirectory, Jobs.getValue(),
+                             preambleCache.get(), outputCache.get());
     }
 
-    ScalaFrontendActionFactory actionFactory(ir);
-    result = Tool.run(&actionFactory);
-
-    ir.generate(ExcludePrefix.getValue());
-    llvm::outs() << ir;
-    llvm::outs().flush();
-    return result;
+    return generateBindings(op.getCompilations(), headers[0], options,
+                            llvm::outs(), llvm::errs(), preambleCache.get(),
+                            outputCache.get());
 }
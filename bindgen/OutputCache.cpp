@@ -0,0 +1,140 @@
+#include "OutputCache.h"
+#include "Utils.h"
+#include <clang/Basic/Version.h>
+#include <fstream>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <sstream>
+
+#ifndef BINDGEN_VERSION
+#define BINDGEN_VERSION "unknown"
+#endif
+
+namespace {
+
+void updateHash(llvm::MD5 &hash, const std::string &value) {
+    /* terminating null character separates values */
+    hash.update(llvm::StringRef(value.c_str(), value.size() + 1));
+}
+
+std::string getDigest(llvm::MD5 &hash) {
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> digest;
+    llvm::MD5::stringifyResult(result, digest);
+    return digest.str();
+}
+
+} // namespace
+
+OutputCache::OutputCache(std::string cacheDirectory)
+    : cacheDirectory(std::move(cacheDirectory)) {
+    /* the directory is created before worker threads start, so the
+     * warning is not interleaved with diagnostics of headers */
+    if (std::error_code ec =
+            llvm::sys::fs::create_directories(this->cacheDirectory)) {
+        llvm::errs() << "Warning: Cannot create output cache directory "
+                     << this->cacheDirectory << ": " << ec.message() << "\n";
+        llvm::errs().flush();
+    }
+}
+
+std::string OutputCache::getKey(const std::string &header,
+                                const std::vector<std::string> &arguments,
+                                const BindingOptions &options) const {
+    llvm::MD5 hash;
+    updateHash(hash, BINDGEN_VERSION);
+    updateHash(hash, clang::getClangFullVersion());
+    updateHash(hash, getRealPath(header.c_str()));
+    updateHash(hash, hashFile(header));
+    for (const auto &argument : arguments) {
+        updateHash(hash, argument);
+    }
+    updateHash(hash, options.libName);
+    updateHash(hash, options.linkName);
+    updateHash(hash, options.objectName);
+    updateHash(hash, options.packageName);
+    updateHash(hash, options.excludePrefix);
+    updateHash(hash, options.lazyTypes ? "lazy-types" : "");
+    if (!options.bindingConfig.empty()) {
+        updateHash(hash, hashFile(options.bindingConfig));
+    }
+    return getDigest(hash);
+}
+
+bool OutputCache::lookup(const std::string &key, std::string &output,
+                         std::string &diagnostics) const {
+    std::ifstream manifest(getPath(key + ".manifest"));
+    if (!manifest) {
+        return false;
+    }
+    llvm::MD5 hash;
+    for (std::string path; getline(manifest, path);) {
+        std::string fileHash = hashFile(path);
+        if (fileHash.empty()) {
+            return false;
+        }
+        updateHash(hash, path);
+        updateHash(hash, fileHash);
+    }
+    std::string outputKey = key + "-" + getDigest(hash);
+    return readFile(getPath(outputKey + ".scala"), output) &&
+           readFile(getPath(outputKey + ".diagnostics"), diagnostics);
+}
+
+void OutputCache::store(const std::string &key,
+                        const std::vector<std::string> &dependencies,
+                        const std::string &output,
+                        const std::string &diagnostics) const {
+    std::stringstream manifest;
+    llvm::MD5 hash;
+    for (const auto &dependency : dependencies) {
+        std::string path = getRealPath(dependency.c_str());
+        std::string fileHash = hashFile(path);
+        if (fileHash.empty()) {
+            /* the result cannot be validated later */
+            return;
+        }
+        manifest << path << "\n";
+        updateHash(hash, path);
+        updateHash(hash, fileHash);
+    }
+    /* output is written before manifest so that a manifest never points to
+     * missing output */
+    std::string outputKey = key + "-" + getDigest(hash);
+    if (writeAtomically(getPath(outputKey + ".diagnostics"), diagnostics) &&
+        writeAtomically(getPath(outputKey + ".scala"), output)) {
+        writeAtomically(getPath(key + ".manifest"), manifest.str());
+    }
+}
+
+std::string OutputCache::hashFile(const std::string &path) const {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path);
+    if (!buffer) {
+        return "";
+    }
+    llvm::MD5 hash;
+    hash.update((*buffer)->getBuffer());
+    return getDigest(hash);
+}
+
+std::string OutputCache::getPath(const std::string &fileName) const {
+    llvm::SmallString<128> path(cacheDirectory);
+    llvm::sys::path::append(path, fileName);
+    return path.str();
+}
+
+bool OutputCache::readFile(const std::string &path,
+                           std::string &content) const {
+    std::ifstream input(path);
+    if (!input) {
+        return false;
+    }
+    std::stringstream s;
+    s << input.rdbuf();
+    content = s.str();
+    return true;
+}
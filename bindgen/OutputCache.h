@@ -0,0 +1,68 @@
+#ifndef SCALA_NATIVE_BINDGEN_OUTPUTCACHE_H
+#define SCALA_NATIVE_BINDGEN_OUTPUTCACHE_H
+
+#include "BindingOptions.h"
+#include <string>
+#include <vector>
+
+/**
+ * On-disk cache of generated bindings.
+ *
+ * Lookup is done in two steps:
+ * 1. Manifest is found by a key that is computed from contents of the
+ *    header, compiler arguments, binding options, contents of binding
+ *    config and bindgen version. The manifest lists all files that the
+ *    header includes.
+ * 2. Generated code is found by a key that is computed from contents of
+ *    all files listed in the manifest. Diagnostics that were printed while
+ *    generating the code are stored next to it.
+ *
+ * Only contents of files are hashed, therefore the cache directory may
+ * be shared by several machines. All files are written atomically.
+ */
+class OutputCache {
+  public:
+    explicit OutputCache(std::string cacheDirectory);
+
+    /**
+     * @return key of the manifest for given header
+     */
+    std::string getKey(const std::string &header,
+                       const std::vector<std::string> &arguments,
+                       const BindingOptions &options) const;
+
+    /**
+     * @param output is set to generated code if it is found
+     * @param diagnostics is set to diagnostics of generated code
+     * @return true if generated code is found
+     */
+    bool lookup(const std::string &key, std::string &output,
+                std::string &diagnostics) const;
+
+    /**
+     * @param dependencies all files that were read while generating code
+     *                     including the header itself
+     */
+    void store(const std::string &key,
+               const std::vector<std::string> &dependencies,
+               const std::string &output,
+               const std::string &diagnostics) const;
+
+  private:
+    std::string cacheDirectory;
+
+    /**
+     * @return hash of file contents or empty string if the file cannot be
+     *         read
+     */
+    std::string hashFile(const std::string &path) const;
+
+    std::string getPath(const std::string &fileName) const;
+
+    /**
+     * @return false if the file cannot be read
+     */
+    bool readFile(const std::string &path, std::string &content) const;
+};
+
+#endif // SCALA_NATIVE_BINDGEN_OUTPUTCACHE_H
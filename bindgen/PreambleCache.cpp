@@ -0,0 +1,275 @@
+#include "PreambleCache.h"
+#include "SystemDependencyCollector.h"
+#include "Utils.h"
+#include <clang/Basic/Version.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/TextDiagnosticPrinter.h>
+#include <clang/Tooling/Tooling.h>
+#include <fstream>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/Chrono.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+#include <sstream>
+
+namespace {
+
+/**
+ * Writes precompiled header to given path.
+ */
+class GeneratePreambleAction : public clang::GeneratePCHAction {
+  public:
+    GeneratePreambleAction(
+        std::string pchPath,
+        std::shared_ptr<SystemDependencyCollector> dependencyCollector)
+        : pchPath(std::move(pchPath)),
+          dependencyCollector(std::move(dependencyCollector)) {}
+
+  protected:
+    bool BeginInvocation(clang::CompilerInstance &CI) override {
+        CI.getFrontendOpts().OutputFile = pchPath;
+        CI.addDependencyCollector(dependencyCollector);
+        return clang::GeneratePCHAction::BeginInvocation(CI);
+    }
+
+  private:
+    std::string pchPath;
+    std::shared_ptr<SystemDependencyCollector> dependencyCollector;
+};
+
+class GeneratePreambleActionFactory
+    : public clang::tooling::FrontendActionFactory {
+  public:
+    GeneratePreambleActionFactory(
+        std::string pchPath,
+        std::shared_ptr<SystemDependencyCollector> dependencyCollector)
+        : pchPath(std::move(pchPath)),
+          dependencyCollector(std::move(dependencyCollector)) {}
+
+    clang::FrontendAction *create() override {
+        return new GeneratePreambleAction(pchPath, dependencyCollector);
+    }
+
+  private:
+    std::string pchPath;
+    std::shared_ptr<SystemDependencyCollector> dependencyCollector;
+};
+
+std::string trim(const std::string &str) {
+    size_t begin = str.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(begin, end - begin + 1);
+}
+
+/**
+ * @return directive name and its argument if line is a preprocessor
+ *         directive, otherwise empty directive name.
+ */
+std::pair<std::string, std::string> parseDirective(const std::string &line) {
+    if (!startsWith(line, "#")) {
+        return {"", ""};
+    }
+    std::string rest = trim(line.substr(1));
+    size_t nameEnd = rest.find_first_of(" \t<\"");
+    if (nameEnd == std::string::npos) {
+        return {rest, ""};
+    }
+    return {rest.substr(0, nameEnd), trim(rest.substr(nameEnd))};
+}
+
+} // namespace
+
+PreambleCache::PreambleCache(std::string cacheDirectory)
+    : cacheDirectory(std::move(cacheDirectory)) {
+    /* the directory is created before worker threads start, so the
+     * warning is not interleaved with diagnostics of headers */
+    if (std::error_code ec =
+            llvm::sys::fs::create_directories(this->cacheDirectory)) {
+        llvm::errs() << "Warning: Cannot create preamble cache directory "
+                     << this->cacheDirectory << ": " << ec.message() << "\n";
+        llvm::errs().flush();
+    }
+}
+
+std::string PreambleCache::getPreamble(
+    const clang::tooling::CompilationDatabase &compilations,
+    const std::string &header, llvm::raw_ostream &diagnostics) {
+    std::string includeBlock = getIncludeBlock(header);
+    if (includeBlock.empty()) {
+        return "";
+    }
+    std::vector<clang::tooling::CompileCommand> commands =
+        compilations.getCompileCommands(header);
+    if (commands.empty()) {
+        return "";
+    }
+    std::vector<std::string> arguments = getCompilerArguments(commands[0]);
+    std::string key = getKey(arguments, includeBlock);
+
+    llvm::SmallString<128> preambleHeader(cacheDirectory);
+    llvm::sys::path::append(preambleHeader, key + ".h");
+    llvm::SmallString<128> pchPath(cacheDirectory);
+    llvm::sys::path::append(pchPath, key + ".pch");
+    llvm::SmallString<128> dependenciesPath(cacheDirectory);
+    llvm::sys::path::append(dependenciesPath, key + ".deps");
+
+    std::lock_guard<std::mutex> lock(getKeyMutex(key));
+    if (llvm::sys::fs::exists(pchPath) && isUpToDate(dependenciesPath.str())) {
+        return pchPath.str();
+    }
+
+    /* the header is not rewritten because precompiled headers that other
+     * processes use check its modification time */
+    if (!llvm::sys::fs::exists(preambleHeader) &&
+        !writeAtomically(preambleHeader.str(), includeBlock)) {
+        diagnostics << "Warning: Cannot write preamble header "
+                    << preambleHeader << "\n";
+        diagnostics.flush();
+        return "";
+    }
+    if (!build(commands[0].Directory, arguments, preambleHeader.str(),
+               pchPath.str(), dependenciesPath.str(), diagnostics)) {
+        diagnostics << "Warning: Failed to build precompiled preamble for "
+                    << header << "\n";
+        diagnostics.flush();
+        return "";
+    }
+    return pchPath.str();
+}
+
+std::mutex &PreambleCache::getKeyMutex(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<std::mutex> &keyMutex = keyMutexes[key];
+    if (!keyMutex) {
+        keyMutex = llvm::make_unique<std::mutex>();
+    }
+    return *keyMutex;
+}
+
+std::string PreambleCache::getIncludeBlock(const std::string &header) const {
+    std::ifstream input(header);
+    std::stringstream includes;
+    bool inComment = false;
+    std::string guardMacro;
+    for (std::string line; getline(input, line);) {
+        line = trim(line);
+        if (inComment) {
+            if (line.find("*/") != std::string::npos) {
+                inComment = false;
+            }
+            continue;
+        }
+        if (line.empty() || startsWith(line, "//")) {
+            continue;
+        }
+        if (startsWith(line, "/*")) {
+            inComment = line.find("*/", 2) == std::string::npos;
+            continue;
+        }
+        std::pair<std::string, std::string> directive = parseDirective(line);
+        if (directive.first == "include" &&
+            startsWith(directive.second, "<")) {
+            includes << "#include " << directive.second << "\n";
+        } else if (directive.first == "pragma" &&
+                   directive.second == "once") {
+            continue;
+        } else if (directive.first == "ifndef" && guardMacro.empty() &&
+                   includes.tellp() == 0) {
+            guardMacro = directive.second;
+        } else if (directive.first == "define" && !guardMacro.empty() &&
+                   directive.second == guardMacro) {
+            continue;
+        } else {
+            break;
+        }
+    }
+    return includes.str();
+}
+
+std::string PreambleCache::getKey(const std::vector<std::string> &arguments,
+                                  const std::string &includeBlock) const {
+    llvm::MD5 hash;
+    hash.update(clang::getClangFullVersion());
+    for (const auto &argument : arguments) {
+        hash.update(llvm::StringRef(argument.c_str(), argument.size() + 1));
+    }
+    hash.update(includeBlock);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> key;
+    llvm::MD5::stringifyResult(result, key);
+    return key.str();
+}
+
+bool PreambleCache::isUpToDate(const std::string &dependenciesPath) const {
+    std::ifstream input(dependenciesPath);
+    if (!input) {
+        return false;
+    }
+    for (std::string line; getline(input, line);) {
+        /* each line contains modification time and path */
+        size_t separator = line.find(' ');
+        if (separator == std::string::npos) {
+            return false;
+        }
+        std::string path = line.substr(separator + 1);
+        llvm::sys::fs::file_status status;
+        if (llvm::sys::fs::status(path, status)) {
+            return false;
+        }
+        if (std::to_string(llvm::sys::toTimeT(
+                status.getLastModificationTime())) !=
+            line.substr(0, separator)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PreambleCache::build(const std::string &directory,
+                          const std::vector<std::string> &arguments,
+                          const std::string &preambleHeader,
+                          const std::string &pchPath,
+                          const std::string &dependenciesPath,
+                          llvm::raw_ostream &diagnostics) const {
+    /* precompiled header is written to a temporary file because other
+     * processes may load the previous one */
+    llvm::SmallString<128> temporaryPchPath;
+    if (llvm::sys::fs::createUniqueFile(pchPath + ".tmp-%%%%%%%%",
+                                        temporaryPchPath)) {
+        return false;
+    }
+    clang::tooling::FixedCompilationDatabase compilations(directory,
+                                                          arguments);
+    clang::tooling::ClangTool tool(compilations, {preambleHeader});
+    clang::TextDiagnosticPrinter diagnosticPrinter(
+        diagnostics, new clang::DiagnosticOptions());
+    tool.setDiagnosticConsumer(&diagnosticPrinter);
+
+    auto dependencyCollector = std::make_shared<SystemDependencyCollector>();
+    GeneratePreambleActionFactory actionFactory(temporaryPchPath.str(),
+                                                dependencyCollector);
+    if (tool.run(&actionFactory) ||
+        llvm::sys::fs::rename(temporaryPchPath, pchPath)) {
+        llvm::sys::fs::remove(temporaryPchPath);
+        return false;
+    }
+
+    /* dependencies file is written last because it marks precompiled
+     * header as valid */
+    std::stringstream dependencies;
+    for (const auto &dependency : dependencyCollector->getDependencies()) {
+        llvm::sys::fs::file_status status;
+        if (llvm::sys::fs::status(dependency, status)) {
+            continue;
+        }
+        dependencies << llvm::sys::toTimeT(status.getLastModificationTime())
+                     << " " << dependency << "\n";
+    }
+    return writeAtomically(dependenciesPath, dependencies.str());
+}
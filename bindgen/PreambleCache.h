@@ -0,0 +1,77 @@
+#ifndef SCALA_NATIVE_BINDGEN_PREAMBLECACHE_H
+#define SCALA_NATIVE_BINDGEN_PREAMBLECACHE_H
+
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/Support/raw_ostream.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Stores precompiled headers for the block of system includes that
+ * headers usually start with.
+ *
+ * Precompiled header is stored in cache directory under a key that is
+ * computed from clang version, compiler flags and the include block.
+ * Next to the precompiled header a list of all headers that it depends on
+ * is saved together with their modification times. The precompiled header
+ * is rebuilt if one of the dependencies was changed.
+ *
+ * The same instance may be used by several threads, only threads that
+ * need the same precompiled header wait for each other. Files are written
+ * to temporary paths and renamed, so the cache directory may be shared by
+ * several processes.
+ */
+class PreambleCache {
+  public:
+    explicit PreambleCache(std::string cacheDirectory);
+
+    /**
+     * Builds precompiled header for the include block of given header
+     * unless it is already in the cache.
+     *
+     * @param diagnostics stream for warnings and errors of clang
+     * @return path to precompiled header or empty string if the header does
+     *         not start with system includes or the precompiled header
+     *         cannot be built.
+     */
+    std::string
+    getPreamble(const clang::tooling::CompilationDatabase &compilations,
+                const std::string &header, llvm::raw_ostream &diagnostics);
+
+  private:
+    std::string cacheDirectory;
+    /* guards keyMutexes */
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<std::mutex>> keyMutexes;
+
+    /**
+     * @return mutex that guards precompiled header with given key
+     */
+    std::mutex &getKeyMutex(const std::string &key);
+
+    /**
+     * @return `#include <...>` directives that header starts with.
+     *         Comments, include guard and `#pragma once` are skipped.
+     */
+    std::string getIncludeBlock(const std::string &header) const;
+
+    std::string getKey(const std::vector<std::string> &arguments,
+                       const std::string &includeBlock) const;
+
+    /**
+     * @return true if all files listed in dependencies file exist and were
+     *         not modified.
+     */
+    bool isUpToDate(const std::string &dependenciesPath) const;
+
+    bool build(const std::string &directory,
+               const std::vector<std::string> &arguments,
+               const std::string &preambleHeader, const std::string &pchPath,
+               const std::string &dependenciesPath,
+               llvm::raw_ostream &diagnostics) const;
+};
+
+#endif // SCALA_NATIVE_BINDGEN_PREAMBLECACHE_H
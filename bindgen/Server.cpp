@@ -0,0 +1,140 @@
+#include "Server.h"
+#include "BindingGenerator.h"
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace {
+
+std::string getString(const json &request, const std::string &key) {
+    auto it = request.find(key);
+    if (it == request.end() || it->is_null()) {
+        return "";
+    }
+    if (!it->is_string()) {
+        throw std::invalid_argument("Invalid request. '" + key +
+                                    "' should be a string.");
+    }
+    return it->get<std::string>();
+}
+
+std::vector<std::string> getStrings(const json &request,
+                                    const std::string &key) {
+    std::vector<std::string> strings;
+    auto it = request.find(key);
+    if (it == request.end() || it->is_null()) {
+        return strings;
+    }
+    if (!it->is_array()) {
+        throw std::invalid_argument("Invalid request. '" + key +
+                                    "' should be an array of strings.");
+    }
+    for (const auto &value : *it) {
+        if (!value.is_string()) {
+            throw std::invalid_argument("Invalid request. '" + key +
+                                        "' should be an array of strings.");
+        }
+        strings.push_back(value.get<std::string>());
+    }
+    return strings;
+}
+
+json handleRequest(const json &request, PreambleCache &preambleCache,
+                   OutputCache *outputCache) {
+    if (!request.is_object()) {
+        throw std::invalid_argument(
+            "Invalid request. Request should be an object.");
+    }
+    std::string header = getString(request, "header");
+    if (header.empty()) {
+        throw std::invalid_argument(
+            "Invalid request. 'header' should be specified.");
+    }
+
+    BindingOptions options;
+    options.libName = getString(request, "name");
+    if (options.libName.empty()) {
+        throw std::invalid_argument(
+            "Invalid request. 'name' should be specified.");
+    }
+    options.linkName = getString(request, "link");
+    if (options.linkName.empty()) {
+        options.linkName = options.libName;
+    }
+    auto noLink = request.find("no-link");
+    if (noLink != request.end() && noLink->is_boolean() &&
+        noLink->get<bool>()) {
+        options.linkName = "";
+    }
+    options.objectName = options.libName;
+    if (options.objectName == "native") {
+        options.objectName = "nativeLib";
+    }
+    options.packageName = getString(request, "package");
+    options.excludePrefix = getString(request, "exclude-prefix");
+    options.bindingConfig = getString(request, "binding-config");
+    auto lazyTypes = request.find("lazy-types");
+    options.lazyTypes = lazyTypes != request.end() &&
+                        lazyTypes->is_boolean() && lazyTypes->get<bool>();
+    options.shimsFile = getString(request, "c-shims");
+
+    std::vector<std::string> arguments =
+        getStrings(request, "extra-args-before");
+    for (const auto &argument : getStrings(request, "extra-args")) {
+        arguments.push_back(argument);
+    }
+    clang::tooling::FixedCompilationDatabase compilations(".", arguments);
+
+    std::string source;
+    llvm::raw_string_ostream out(source);
+    int result = generateBindings(compilations, header, options, out,
+                                  llvm::errs(), &preambleCache, outputCache);
+    out.flush();
+
+    json response;
+    response["exit-code"] = result;
+    response["source"] = source;
+    return response;
+}
+
+/**
+ * @return serialized error response
+ */
+std::string getErrorResponse(const std::string &message) {
+    json response;
+    response["exit-code"] = -1;
+    response["error"] = message;
+    try {
+        return response.dump();
+    } catch (const std::exception &) {
+        /* the message may contain a path that is not valid UTF-8 */
+        response["error"] = "Error message is not valid UTF-8";
+        return response.dump();
+    }
+}
+
+} // namespace
+
+int serve(std::istream &input, llvm::raw_ostream &output,
+          PreambleCache &preambleCache, OutputCache *outputCache) {
+    for (std::string line; getline(input, line);) {
+        if (line.empty()) {
+            continue;
+        }
+        std::string response;
+        try {
+            /* serialization throws if generated source or a path is not
+             * valid UTF-8 */
+            response = handleRequest(json::parse(line), preambleCache,
+                                     outputCache)
+                           .dump();
+        } catch (const std::exception &e) {
+            response = getErrorResponse(e.what());
+        }
+        output << response << "\n";
+        output.flush();
+        llvm::errs().flush();
+    }
+    return 0;
+}
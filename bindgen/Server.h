@@ -0,0 +1,40 @@
+#ifndef SCALA_NATIVE_BINDGEN_SERVER_H
+#define SCALA_NATIVE_BINDGEN_SERVER_H
+
+#include "OutputCache.h"
+#include "PreambleCache.h"
+#include <istream>
+#include <llvm/Support/raw_ostream.h>
+
+/**
+ * Reads requests from input and writes responses to output until input is
+ * closed. Each request and response is a JSON object on a separate line.
+ *
+ * Request fields mirror BindingOptions of the sbt plugin:
+ * @code
+ * {"header": "/path/to/lib.h", "name": "lib", "link": "lib",
+ *  "no-link": false, "package": "org.example", "exclude-prefix": "__",
+ *  "binding-config": "/path/to/config.json", "lazy-types": false,
+ *  "c-shims": "/path/to/lib_shims.c", "extra-args": [],
+ *  "extra-args-before": []}
+ * @endcode
+ *
+ * Response contains clang tool exit code and generated source:
+ * @code
+ * {"exit-code": 0, "source": "..."}
+ * @endcode
+ * or an error message if request is invalid or the response is not
+ * valid UTF-8:
+ * @code
+ * {"exit-code": -1, "error": "..."}
+ * @endcode
+ *
+ * Warnings are reported to llvm::errs() as in a regular run.
+ *
+ * @param preambleCache keeps precompiled system includes between requests
+ * @param outputCache may be nullptr
+ */
+int serve(std::istream &input, llvm::raw_ostream &output,
+          PreambleCache &preambleCache, OutputCache *outputCache);
+
+#endif // SCALA_NATIVE_BINDGEN_SERVER_H
@@ -0,0 +1,15 @@
+#ifndef SCALA_NATIVE_BINDGEN_SYSTEMDEPENDENCYCOLLECTOR_H
+#define SCALA_NATIVE_BINDGEN_SYSTEMDEPENDENCYCOLLECTOR_H
+
+#include <clang/Frontend/Utils.h>
+
+/**
+ * Collects all files that are read by the preprocessor including
+ * system headers.
+ */
+class SystemDependencyCollector : public clang::DependencyCollector {
+  public:
+    bool needSystemDependencies() override { return true; }
+};
+
+#endif // SCALA_NATIVE_BINDGEN_SYSTEMDEPENDENCYCOLLECTOR_H
@@ -2,35 +2,116 @@
 #include "Utils.h"
 #include "ir/types/FunctionPointerType.h"
 #include "clang/AST/RecordLayout.h"
+#include <algorithm>
+
+TypeTranslator::TypeTranslator(clang::ASTContext *ctx_, IR &ir,
+                               bool lazyTypes)
+    : ctx(ctx_), ir(ir), lazyTypes(lazyTypes) {}
+
+std::string
+TypeTranslator::getBuiltinTypeName(const clang::BuiltinType *builtin) const {
+    switch (builtin->getKind()) {
+    case clang::BuiltinType::Void:
+        return "Unit";
+    case clang::BuiltinType::Bool:
+        return "native.CBool";
+    case clang::BuiltinType::Char_S:
+    case clang::BuiltinType::Char_U:
+        return "native.CChar";
+    case clang::BuiltinType::SChar:
+        return "native.CSignedChar";
+    case clang::BuiltinType::UChar:
+        return "native.CUnsignedChar";
+    case clang::BuiltinType::Short:
+        return "native.CShort";
+    case clang::BuiltinType::UShort:
+        return "native.CUnsignedShort";
+    case clang::BuiltinType::Int:
+        return "native.CInt";
+    case clang::BuiltinType::UInt:
+        return "native.CUnsignedInt";
+    case clang::BuiltinType::Long:
+    case clang::BuiltinType::ULong:
+        /* native.CLong is 64-bit */
+        if (ctx->getTypeSize(builtin) != 64) {
+            break;
+        }
+        return builtin->getKind() == clang::BuiltinType::Long
+                   ? "native.CLong"
+                   : "native.CUnsignedLong";
+    case clang::BuiltinType::LongLong:
+        return "native.CLongLong";
+    case clang::BuiltinType::ULongLong:
+        return "native.CUnsignedLongLong";
+    case clang::BuiltinType::WChar_S:
+    case clang::BuiltinType::WChar_U:
+        /* native.CWideChar is 32-bit */
+        if (ctx->getTypeSize(builtin) != 32) {
+            break;
+        }
+        return "native.CWideChar";
+    case clang::BuiltinType::Char16:
+        return "native.CChar16";
+    case clang::BuiltinType::Char32:
+        return "native.CChar32";
+    case clang::BuiltinType::Float:
+        return "native.CFloat";
+    case clang::BuiltinType::Double:
+    case clang::BuiltinType::LongDouble:
+        return "native.CDouble";
+    default:
+        break;
+    }
+    /* other integer types are mapped to a type of the same width */
+    if (builtin->isInteger()) {
+        bool isSigned = builtin->isSignedInteger();
+        switch (ctx->getTypeSize(builtin)) {
+        case 8:
+            return isSigned ? "native.CSignedChar" : "native.CUnsignedChar";
+        case 16:
+            return isSigned ? "native.CShort" : "native.CUnsignedShort";
+        case 32:
+            return isSigned ? "native.CInt" : "native.CUnsignedInt";
+        case 64:
+            return isSigned ? "native.CLongLong" : "native.CUnsignedLongLong";
+        default:
+            break;
+        }
+    }
+    return "";
+}
 
-TypeTranslator::TypeTranslator(clang::ASTContext *ctx_, IR &ir)
-    : ctx(ctx_), ir(ir), typeMap() {
-
-    // Native Types
-    typeMap["void"] = "Unit";
-    typeMap["bool"] = "native.CBool";
-    typeMap["_Bool"] = "native.CBool";
-    typeMap["char"] = "native.CChar";
-    typeMap["signed char"] = "native.CSignedChar";
-    typeMap["unsigned char"] = "native.CUnsignedChar";
-    typeMap["short"] = "native.CShort";
-    typeMap["unsigned short"] = "native.CUnsignedShort";
-    typeMap["int"] = "native.CInt";
-    typeMap["long int"] = "native.CLongInt";
-    typeMap["unsigned int"] = "native.CUnsignedInt";
-    typeMap["unsigned long int"] = "native.CUnsignedLongInt";
-    typeMap["long"] = "native.CLong";
-    typeMap["unsigned long"] = "native.CUnsignedLong";
-    typeMap["long long"] = "native.CLongLong";
-    typeMap["unsigned long long"] = "native.CUnsignedLongLong";
-    typeMap["size_t"] = "native.CSize";
-    typeMap["ptrdiff_t"] = "native.CPtrDiff";
-    typeMap["wchar_t"] = "native.CWideChar";
-    typeMap["char16_t"] = "native.CChar16";
-    typeMap["char32_t"] = "native.CChar32";
-    typeMap["float"] = "native.CFloat";
-    typeMap["double"] = "native.CDouble";
-    typeMap["long double"] = "native.CDouble";
+std::shared_ptr<Type>
+TypeTranslator::translateTypedef(const clang::TypedefType *typedefType) {
+    const clang::TypedefNameDecl *decl = typedefType->getDecl();
+    auto it = typedefTypes.find(decl);
+    if (it != typedefTypes.end()) {
+        return it->second;
+    }
+    std::string name = decl->getName();
+    std::shared_ptr<Type> type;
+    if (name == "size_t") {
+        type = ir.getTypeFactory().getPrimitiveType("native.CSize");
+    } else if (name == "ptrdiff_t") {
+        type = ir.getTypeFactory().getPrimitiveType("native.CPtrDiff");
+    } else if (name == "wchar_t") {
+        type = ir.getTypeFactory().getPrimitiveType("native.CWideChar");
+    } else if (name == "char16_t") {
+        type = ir.getTypeFactory().getPrimitiveType("native.CChar16");
+    } else if (name == "char32_t") {
+        type = ir.getTypeFactory().getPrimitiveType("native.CChar32");
+    } else {
+        type = ir.getTypeDefWithName(name);
+        if (!type) {
+            translateReferencedDeclaration(clang::QualType(typedefType, 0));
+            type = ir.getTypeDefWithName(name);
+        }
+    }
+    if (type) {
+        /* the first typedef with given name never changes */
+        typedefTypes[decl] = type;
+    }
+    return type;
 }
 
 std::shared_ptr<Type>
@@ -47,7 +128,7 @@ TypeTranslator::translateFunctionPointer(const clang::QualType &qtpe) {
             parametersTypes.push_back(translate(param));
         }
 
-        return std::make_shared<FunctionPointerType>(
+        return ir.getTypeFactory().getFunctionPointerType(
             returnType, parametersTypes, fc->isVariadic());
 
     } else {
@@ -66,45 +147,60 @@ TypeTranslator::translatePointer(const clang::QualType &pte) {
 
         // Take care of void*
         if (as->getKind() == clang::BuiltinType::Void) {
-            return std::make_shared<PointerType>(
-                std::make_shared<PrimitiveType>("Byte"));
+            TypeFactory &typeFactory = ir.getTypeFactory();
+            return typeFactory.getPointerType(
+                typeFactory.getPrimitiveType("Byte"));
         }
 
         // Take care of char*
         if (as->getKind() == clang::BuiltinType::Char_S ||
             as->getKind() == clang::BuiltinType::SChar) {
             // TODO: new PointerType(new PrimitiveType("native.CChar"))
-            return std::make_shared<PrimitiveType>("native.CString");
+            return ir.getTypeFactory().getPrimitiveType("native.CString");
         }
     }
 
-    return std::make_shared<PointerType>(translate(pte));
+    return ir.getTypeFactory().getPointerType(translate(pte));
 }
 
 std::shared_ptr<Type>
 TypeTranslator::translateNonAnonymousRecord(const clang::QualType &qtpe) {
-    std::string name = qtpe.getUnqualifiedType().getAsString();
-
     /* If the struct was already declared then there is a TypeDef instance
      * with appropriate name.
      *
      * If there is no such TypeDef then the type is opaque and TypeDef with
      * nullptr will be generated for the type. */
 
-    std::shared_ptr<TypeDef> typeDef = ir.getTypeDefWithName(name);
-    if (typeDef) {
-        return typeDef;
+    std::string name;
+    if (const auto *typedefType = qtpe->getAs<clang::TypedefType>()) {
+        std::shared_ptr<Type> type = translateTypedef(typedefType);
+        if (type) {
+            return type;
+        }
+        name = typedefType->getDecl()->getName();
+    } else {
+        name = qtpe.getUnqualifiedType().getAsString();
+        std::shared_ptr<TypeDef> typeDef = ir.getTypeDefWithName(name);
+        if (typeDef) {
+            return typeDef;
+        }
+        translateReferencedDeclaration(qtpe);
+        typeDef = ir.getTypeDefWithName(name);
+        if (typeDef) {
+            return typeDef;
+        }
     }
     /* type is not yet defined.
      * TypeDef with nullptr will be created.
      * nullptr will be replaced by actual type when the type is declared. */
-    typeDef = ir.addTypeDef(name, nullptr, nullptr);
-    return typeDef;
+    return ir.addTypeDef(name, nullptr, nullptr);
 }
 
 std::shared_ptr<Type>
 TypeTranslator::translateRecord(const clang::QualType &qtpe) {
     if (qtpe->hasUnnamedOrLocalType()) {
+        /* new definition is added on each usage */
+        isCacheable = false;
         if (qtpe->isStructureType()) {
             std::string name =
                 "anonymous_" + std::to_string(anonymousStructId++);
@@ -126,16 +222,34 @@ TypeTranslator::translateConstantArray(const clang::ConstantArrayType *ar) {
     const uint64_t size = ar->getSize().getZExtValue();
     std::shared_ptr<Type> elementType = translate(ar->getElementType());
     if (elementType == nullptr) {
-        llvm::errs() << "Failed to translate array type "
-                     << ar->getElementType().getAsString() << "\n";
-        elementType = std::make_shared<PrimitiveType>("Byte");
+        ir.getDiagnostics() << "Failed to translate array type "
+                            << ar->getElementType().getAsString() << "\n";
+        elementType = ir.getTypeFactory().getPrimitiveType("Byte");
     }
 
-    return std::make_shared<ArrayType>(elementType, size);
+    return ir.getTypeFactory().getArrayType(elementType, size);
 }
 
 std::shared_ptr<Type> TypeTranslator::translate(const clang::QualType &qtpe) {
+    auto it = translatedTypes.find(qtpe);
+    if (it != translatedTypes.end()) {
+        return it->second;
+    }
 
+    bool outerIsCacheable = isCacheable;
+    isCacheable = true;
+    std::shared_ptr<Type> type = translateUncached(qtpe);
+    /* nullptr is not cached because a typedef or an enum may be
+     * declared later */
+    if (isCacheable && type) {
+        translatedTypes[qtpe] = type;
+    }
+    isCacheable = outerIsCacheable && isCacheable;
+    return type;
+}
+
+std::shared_ptr<Type>
+TypeTranslator::translateUncached(const clang::QualType &qtpe) {
     const clang::Type *tpe = qtpe.getTypePtr();
 
     if (tpe->isFunctionType()) {
@@ -159,33 +273,33 @@ std::shared_ptr<Type> TypeTranslator::translate(const clang::QualType &qtpe) {
         return translateConstantArray(ctx->getAsConstantArrayType(qtpe));
     } else if (qtpe->isArrayType()) {
         return translatePointer(ctx->getAsArrayType(qtpe)->getElementType());
-    } else {
+    } else if (const auto *typedefType = tpe->getAs<clang::TypedefType>()) {
+        return translateTypedef(typedefType);
 
-        auto found = typeMap.find(qtpe.getUnqualifiedType().getAsString());
-        if (found != typeMap.end()) {
-            return std::make_shared<PrimitiveType>(found->second);
-        } else {
-            return ir.getTypeDefWithName(
-                qtpe.getUnqualifiedType().getAsString());
+    } else if (const auto *builtin = tpe->getAs<clang::BuiltinType>()) {
+        std::string name = getBuiltinTypeName(builtin);
+        if (name.empty()) {
+            return nullptr;
         }
+        return ir.getTypeFactory().getPrimitiveType(name);
     }
-}
-
-std::string TypeTranslator::getTypeFromTypeMap(std::string cType) {
-    auto it = typeMap.find(cType);
-    if (it != typeMap.end()) {
-        return (*it).second;
-    }
-    return "";
+    return nullptr;
 }
 
 std::shared_ptr<Location> TypeTranslator::getLocation(clang::Decl *decl) {
     clang::SourceManager &sm = ctx->getSourceManager();
-    std::string filename = std::string(sm.getFilename(decl->getLocation()));
-    std::string path = getRealPath(filename.c_str());
+    clang::FileID fileID = sm.getFileID(decl->getLocation());
+    auto it = fileIndexes.find(fileID);
+    if (it == fileIndexes.end()) {
+        std::string filename =
+            std::string(sm.getFilename(decl->getLocation()));
+        std::string path = getRealPath(filename.c_str());
+        unsigned fileIndex = ir.getLocationManager().getFileIndex(path);
+        it = fileIndexes.insert(std::make_pair(fileID, fileIndex)).first;
+    }
 
     unsigned lineNumber = sm.getSpellingLineNumber(decl->getLocation());
-    return std::make_shared<Location>(path, lineNumber);
+    return ir.getArena().make<Location>(it->second, lineNumber);
 }
 
 std::shared_ptr<TypeDef>
@@ -197,7 +311,7 @@ TypeTranslator::addUnionDefinition(clang::RecordDecl *record,
         std::string fname = field->getNameAsString();
         std::shared_ptr<Type> ftype = translate(field->getType());
 
-        fields.push_back(std::make_shared<Field>(fname, ftype));
+        fields.push_back(ir.getArena().make<Field>(fname, ftype));
     }
 
     uint64_t sizeInBits = ctx->getTypeSize(record->getTypeForDecl());
@@ -210,50 +324,211 @@ TypeTranslator::addUnionDefinition(clang::RecordDecl *record,
 std::shared_ptr<TypeDef>
 TypeTranslator::addStructDefinition(clang::RecordDecl *record,
                                     std::string name) {
-    if (record->hasAttr<clang::PackedAttr>()) {
-        llvm::errs() << "Warning: struct " << name << " is packed. "
-                     << "Packed structs are not supported by Scala Native. "
-                     << "Access to fields will not work correctly.\n";
-        llvm::errs().flush();
-    }
-
     std::vector<std::shared_ptr<Field>> fields;
     const clang::ASTRecordLayout &recordLayout =
         ctx->getASTRecordLayout(record);
 
+    /* packed attribute and `#pragma pack` do not always change the layout,
+     * the struct is treated as packed only if some field is placed below
+     * its natural alignment */
+    bool isPacked = false;
+    uint64_t maxFieldAlignInBits = 8;
     bool isBitFieldStruct = false;
     for (const clang::FieldDecl *field : record->fields()) {
+        unsigned bitFieldWidth = 0;
         if (field->isBitField()) {
             isBitFieldStruct = true;
+            /* accessors of bit fields mask and shift the integer
+             * that contains the field */
+            bitFieldWidth = field->getBitWidthValue(*ctx);
         }
         std::shared_ptr<Type> ftype = translate(field->getType());
         uint64_t recordOffsetInBits =
             recordLayout.getFieldOffset(field->getFieldIndex());
-        fields.push_back(std::make_shared<Field>(field->getNameAsString(),
-                                                 ftype, recordOffsetInBits));
+        uint64_t alignInBits = ctx->getTypeAlign(field->getType());
+        maxFieldAlignInBits = std::max(maxFieldAlignInBits, alignInBits);
+        if (!field->isBitField()) {
+            isPacked |= recordOffsetInBits % alignInBits != 0;
+        } else if (bitFieldWidth > 0) {
+            /* aligned bit field does not cross alignment boundary */
+            uint64_t lastBit = recordOffsetInBits + bitFieldWidth - 1;
+            isPacked |=
+                recordOffsetInBits / alignInBits != lastBit / alignInBits;
+        }
+        fields.push_back(ir.getArena().make<Field>(field->getNameAsString(),
+                                                   ftype, recordOffsetInBits,
+                                                   bitFieldWidth));
     }
 
+    /* size of the struct may lack trailing padding */
+    isPacked |=
+        ctx->getTypeAlign(record->getTypeForDecl()) < maxFieldAlignInBits;
+
     uint64_t sizeInBits = ctx->getTypeSize(record->getTypeForDecl());
     assert(sizeInBits % 8 == 0);
 
     return ir.addStruct(name, std::move(fields), sizeInBits / 8,
-                        getLocation(record),
-                        record->hasAttr<clang::PackedAttr>(), isBitFieldStruct);
+                        getLocation(record), isPacked, isBitFieldStruct);
 }
 
 std::shared_ptr<Type>
 TypeTranslator::translateEnum(const clang::QualType &type) {
     clang::EnumDecl *enumDecl = type->getAs<clang::EnumType>()->getDecl();
     if (type->hasUnnamedOrLocalType()) {
-        return std::make_shared<PrimitiveType>(getTypeFromTypeMap(
-            enumDecl->getIntegerType().getUnqualifiedType().getAsString()));
+        return ir.getTypeFactory().getPrimitiveType(
+            getEnumIntegerTypeName(enumDecl));
     }
     std::string name = enumDecl->getNameAsString();
 
     if (name.empty()) {
         name = enumDecl->getTypedefNameForAnonDecl()->getNameAsString();
-        return ir.getTypeDefWithName(name);
+        std::shared_ptr<TypeDef> typeDef = ir.getTypeDefWithName(name);
+        if (!typeDef) {
+            translateReferencedDeclaration(type);
+            typeDef = ir.getTypeDefWithName(name);
+        }
+        return typeDef;
     }
     assert(!name.empty());
-    return ir.getEnumWithName(name);
+    std::shared_ptr<Enum> e = ir.getEnumWithName(name);
+    if (!e) {
+        translateReferencedDeclaration(type);
+        e = ir.getEnumWithName(name);
+    }
+    return e;
+}
+
+void TypeTranslator::addTypeDefDefinition(clang::TypedefDecl *tpdef) {
+    std::string name = tpdef->getName();
+
+    if (isAliasForAnonymousEnum(tpdef)) {
+        /* typedef was already created */
+        return;
+    }
+
+    std::shared_ptr<Type> type = translate(tpdef->getUnderlyingType());
+    if (type) {
+        ir.addTypeDef(name, type, getLocation(tpdef));
+    }
+}
+
+bool TypeTranslator::isAliasForAnonymousEnum(
+    clang::TypedefDecl *tpdef) const {
+    clang::QualType underlyingType = tpdef->getUnderlyingType();
+    if (!underlyingType->isEnumeralType()) {
+        return false;
+    }
+    const clang::EnumType *enumType = underlyingType->getAs<clang::EnumType>();
+    return enumType->getDecl()->getTypedefNameForAnonDecl();
+}
+
+void TypeTranslator::addEnumDefinition(clang::EnumDecl *enumDecl) {
+    std::string name = enumDecl->getNameAsString();
+
+    clang::TypedefNameDecl *typedefName = enumDecl->getTypedefNameForAnonDecl();
+    if (name.empty() && typedefName) {
+        name = typedefName->getNameAsString();
+    }
+
+    std::vector<Enumerator> enumerators;
+
+    for (const clang::EnumConstantDecl *en : enumDecl->enumerators()) {
+        int64_t value = en->getInitVal().getSExtValue();
+        enumerators.emplace_back(en->getNameAsString(), value);
+    }
+
+    std::string scalaType = getEnumIntegerTypeName(enumDecl);
+
+    std::shared_ptr<Location> location = getLocation(enumDecl);
+    if (name.empty()) {
+        name = "anonymous_" + std::to_string(anonymousEnumId++);
+    }
+    std::shared_ptr<Enum> e =
+        ir.addEnum(name, scalaType, std::move(enumerators), location);
+
+    if (typedefName) {
+        /* add alias here because in addTypeDefDefinition it will be
+         * difficult to match typedef with enum */
+        ir.addTypeDef(name, e, getLocation(typedefName));
+    }
+}
+
+bool TypeTranslator::addRecordDefinition(clang::RecordDecl *record) {
+    std::string name = record->getNameAsString();
+
+    // Handle typedef struct {} x; and typedef union {} y; by getting the name
+    // from the typedef
+    if ((record->isStruct() || record->isUnion()) && name.empty() &&
+        record->getTypedefNameForAnonDecl()) {
+        name = record->getTypedefNameForAnonDecl()->getNameAsString();
+    }
+
+    if (record->isUnion() && record->isThisDeclarationADefinition() &&
+        !record->isAnonymousStructOrUnion() && !name.empty()) {
+        addUnionDefinition(record, name);
+        return true;
+
+    } else if (record->isStruct() && record->isThisDeclarationADefinition() &&
+               !record->isAnonymousStructOrUnion() && !name.empty()) {
+        addStructDefinition(record, name);
+        return true;
+    }
+    return false;
+}
+
+std::string
+TypeTranslator::getEnumIntegerTypeName(const clang::EnumDecl *enumDecl) const {
+    clang::QualType integerType = enumDecl->getIntegerType();
+    if (integerType.isNull()) {
+        /* forward declaration of enum */
+        return "";
+    }
+    return getBuiltinTypeName(
+        integerType.getCanonicalType()->castAs<clang::BuiltinType>());
+}
+
+bool TypeTranslator::isInMainFile(const clang::Decl *decl) const {
+    return ctx->getSourceManager().isInMainFile(decl->getLocation());
+}
+
+void TypeTranslator::translateReferencedDeclaration(
+    const clang::QualType &qtpe) {
+    if (!lazyTypes) {
+        return;
+    }
+    /* declarations from the main header are translated by TreeVisitor */
+    const auto *typedefType = qtpe->getAs<clang::TypedefType>();
+    if (typedefType) {
+        auto *tpdef =
+            llvm::dyn_cast<clang::TypedefDecl>(typedefType->getDecl());
+        if (tpdef && !isInMainFile(tpdef)) {
+            if (isAliasForAnonymousEnum(tpdef)) {
+                /* typedef is added together with the enum */
+                addEnumDefinition(tpdef->getUnderlyingType()
+                                      ->getAs<clang::EnumType>()
+                                      ->getDecl());
+            } else {
+                addTypeDefDefinition(tpdef);
+            }
+        }
+        return;
+    }
+    if (const auto *enumType = qtpe->getAs<clang::EnumType>()) {
+        clang::EnumDecl *enumDecl = enumType->getDecl()->getDefinition();
+        if (enumDecl && !isInMainFile(enumDecl)) {
+            addEnumDefinition(enumDecl);
+        }
+        return;
+    }
+    if (const auto *recordType = qtpe->getAs<clang::RecordType>()) {
+        clang::RecordDecl *record = recordType->getDecl()->getDefinition();
+        if (record && !isInMainFile(record)) {
+            /* opaque typedef is added first because fields may reference
+             * the record. It is replaced by actual type in addStruct and
+             * addUnion */
+            ir.addTypeDef(qtpe.getUnqualifiedType().getAsString(), nullptr,
+                          nullptr);
+            addRecordDefinition(record);
+        }
+    }
 }
@@ -1,11 +1,17 @@
 #pragma once
 
 #include "ir/IR.h"
+#include <clang/AST/TypeOrdering.h>
 #include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/DenseMap.h>
 
 class TypeTranslator {
   public:
-    TypeTranslator(clang::ASTContext *ctx, IR &ir);
+    /**
+     * @param lazyTypes if true then types from included headers are
+     *                  translated when they are referenced
+     */
+    TypeTranslator(clang::ASTContext *ctx, IR &ir, bool lazyTypes = false);
 
     /**
      * @brief Translate the qualified type from c to a scala type
@@ -14,8 +20,6 @@ class TypeTranslator {
      */
     std::shared_ptr<Type> translate(const clang::QualType &tpe);
 
-    std::string getTypeFromTypeMap(std::string cType);
-
     std::shared_ptr<TypeDef> addUnionDefinition(clang::RecordDecl *record,
                                                 std::string name);
 
@@ -24,16 +28,52 @@ class TypeTranslator {
 
     std::shared_ptr<Location> getLocation(clang::Decl *decl);
 
+    void addTypeDefDefinition(clang::TypedefDecl *tpdef);
+
+    void addEnumDefinition(clang::EnumDecl *enumDecl);
+
+    /**
+     * Adds struct or union if the declaration is a definition of named
+     * record.
+     * @return false if the declaration is not translated
+     */
+    bool addRecordDefinition(clang::RecordDecl *record);
+
+    bool isInMainFile(const clang::Decl *decl) const;
+
   private:
     clang::ASTContext *ctx;
     IR &ir;
+    bool lazyTypes;
     int anonymousStructId = 0;
     int anonymousUnionId = 0;
+    uint anonymousEnumId = 0;
+
+    /**
+     * Translated typedef types.
+     * Contains only typedefs that were found.
+     */
+    llvm::DenseMap<const clang::TypedefNameDecl *, std::shared_ptr<Type>>
+        typedefTypes;
+
+    /**
+     * Translated types by sugared qualified type.
+     * Types that reference anonymous records are not cached.
+     */
+    llvm::DenseMap<clang::QualType, std::shared_ptr<Type>> translatedTypes;
 
     /**
-     * Primitive types
+     * false if current translation added a definition of anonymous record
      */
-    std::map<std::string, std::string> typeMap;
+    bool isCacheable = true;
+
+    /**
+     * Indexes of files in LocationManager.
+     * Real path of a file is resolved once.
+     */
+    llvm::DenseMap<clang::FileID, unsigned> fileIndexes;
+
+    std::shared_ptr<Type> translateUncached(const clang::QualType &qtpe);
 
     std::shared_ptr<Type>
     translateNonAnonymousRecord(const clang::QualType &qtpe);
@@ -48,4 +88,23 @@ class TypeTranslator {
     translateConstantArray(const clang::ConstantArrayType *ar);
 
     std::shared_ptr<Type> translateEnum(const clang::QualType &type);
+
+    std::shared_ptr<Type>
+    translateTypedef(const clang::TypedefType *typedefType);
+
+    /**
+     * @return name of Scala type that has the same width as the builtin
+     *         type or empty string if the type is not supported
+     */
+    std::string getBuiltinTypeName(const clang::BuiltinType *builtin) const;
+
+    std::string getEnumIntegerTypeName(const clang::EnumDecl *enumDecl) const;
+
+    bool isAliasForAnonymousEnum(clang::TypedefDecl *tpdef) const;
+
+    /**
+     * In lazy mode translates declaration of referenced type if it is
+     * located in included header and was not translated yet.
+     */
+    void translateReferencedDeclaration(const clang::QualType &qtpe);
 };
@@ -3,7 +3,11 @@
 
 #include "ir/TypeDef.h"
 #include "ir/types/Type.h"
+#include <cctype>
 #include <clang/AST/AST.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
 
 inline std::string uint64ToScalaNat(uint64_t v, std::string accumulator = "") {
     if (v == 0)
@@ -41,6 +45,24 @@ inline std::string handleReservedWords(const std::string &name,
     }
 }
 
+/**
+ * @return name in which characters that are not allowed in Scala
+ *         identifiers are replaced with underscores
+ */
+static inline std::string toIdentifier(const std::string &name) {
+    std::string identifier = name;
+    for (char &c : identifier) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+            c = '_';
+        }
+    }
+    if (identifier.empty() ||
+        std::isdigit(static_cast<unsigned char>(identifier[0]))) {
+        identifier = "_" + identifier;
+    }
+    return identifier;
+}
+
 /**
  * @return true if str starts with given prefix
  */
@@ -56,11 +78,6 @@ static inline bool endsWith(const std::string &str, const std::string &suffix) {
     return str.substr(str.length() - suffix.size(), str.length()) == suffix;
 }
 
-template <typename T, typename PT> static inline bool isInstanceOf(PT *type) {
-    auto *p = dynamic_cast<const T *>(type);
-    return p != nullptr;
-}
-
 static inline std::string replaceChar(const std::string &str,
                                       const std::string &c1,
                                       const std::string &c2) {
@@ -76,12 +93,11 @@ static inline std::string replaceChar(const std::string &str,
  * @return true if given type is of type T or is an alias for type T.
  */
 template <typename T> static inline bool isAliasForType(const Type *type) {
-    if (isInstanceOf<T>(type)) {
+    if (isa<T>(type)) {
         return true;
     }
-    auto *typeDef = dynamic_cast<const TypeDef *>(type);
-    if (typeDef) {
-        return isAliasForType<const T>(typeDef->getType().get());
+    if (auto *typeDef = dyn_cast<TypeDef>(type)) {
+        return isAliasForType<T>(typeDef->getType().get());
     }
     return false;
 }
@@ -92,8 +108,7 @@ template <typename T> static inline bool isAliasForType(const Type *type) {
  */
 static inline bool isAliasForOpaqueType(const Type *type) {
     assert(type);
-    auto *typeDef = dynamic_cast<const TypeDef *>(type);
-    if (typeDef) {
+    if (auto *typeDef = dyn_cast<TypeDef>(type)) {
         if (!typeDef->getType()) {
             return true;
         }
@@ -103,7 +118,7 @@ static inline bool isAliasForOpaqueType(const Type *type) {
 }
 
 static inline bool contains(const Type *type,
-                            std::vector<std::shared_ptr<const Type>> &types) {
+                            const std::vector<const Type *> &types) {
     for (const auto &t : types) {
         if (*type == *t) {
             return true;
@@ -125,4 +140,47 @@ static inline std::string getRealPath(const char *filename) {
     return path;
 }
 
+/**
+ * @return compiler arguments without tool name, input file and output
+ *         options.
+ */
+static inline std::vector<std::string>
+getCompilerArguments(const clang::tooling::CompileCommand &command) {
+    std::vector<std::string> arguments;
+    const std::vector<std::string> &commandLine = command.CommandLine;
+    for (size_t i = 1; i < commandLine.size(); i++) {
+        const std::string &argument = commandLine[i];
+        if (argument == "-o") {
+            i++; // skip output file
+        } else if (argument != "-c" && argument != command.Filename &&
+                   !startsWith(argument, "-o")) {
+            arguments.push_back(argument);
+        }
+    }
+    return arguments;
+}
+
+/**
+ * Writes content to a temporary file and renames it to given path,
+ * so other processes never see a partially written file.
+ */
+static inline bool writeAtomically(const std::string &path,
+                                   const std::string &content) {
+    int fd;
+    llvm::SmallString<128> temporaryPath;
+    if (llvm::sys::fs::createUniqueFile(path + ".tmp-%%%%%%%%", fd,
+                                        temporaryPath)) {
+        return false;
+    }
+    {
+        llvm::raw_fd_ostream output(fd, /*shouldClose=*/true);
+        output << content;
+    }
+    if (llvm::sys::fs::rename(temporaryPath, path)) {
+        llvm::sys::fs::remove(temporaryPath);
+        return false;
+    }
+    return true;
+}
+
 #endif // UTILS_H
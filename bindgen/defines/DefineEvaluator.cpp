@@ -0,0 +1,234 @@
+#include "DefineEvaluator.h"
+#include "../Utils.h"
+#include <clang/Lex/Pragma.h>
+#include <clang/Lex/Preprocessor.h>
+#include <cmath>
+#include <iomanip>
+#include <llvm/Support/MemoryBuffer.h>
+#include <sstream>
+
+namespace {
+
+const std::string pragmaNamespace = "scala_native_bindgen";
+
+const std::string pragmaName = "defines";
+
+const std::string variablePrefix = "__scala_native_bindgen_define_";
+
+/**
+ * @return name of Scala type that has the same width and signedness as
+ *         the integer type
+ */
+std::string getIntegerTypeName(const clang::ASTContext &context,
+                               clang::QualType type) {
+    if (type->isBooleanType()) {
+        return "native.CBool";
+    }
+    bool isSigned = type->isSignedIntegerOrEnumerationType();
+    switch (context.getTypeSize(type)) {
+    case 8:
+        if (type->isCharType()) {
+            return "native.CChar";
+        }
+        return isSigned ? "native.CSignedChar" : "native.CUnsignedChar";
+    case 16:
+        return isSigned ? "native.CShort" : "native.CUnsignedShort";
+    case 32:
+        return isSigned ? "native.CInt" : "native.CUnsignedInt";
+    case 64:
+        if (type->isSpecificBuiltinType(clang::BuiltinType::LongLong) ||
+            type->isSpecificBuiltinType(clang::BuiltinType::ULongLong)) {
+            return isSigned ? "native.CLongLong" : "native.CUnsignedLongLong";
+        }
+        return isSigned ? "native.CLong" : "native.CUnsignedLong";
+    default:
+        return "";
+    }
+}
+
+/**
+ * Scala does not have unsigned literals, therefore unsigned values are
+ * written as signed numbers of the same width and converted.
+ */
+std::string getIntegerLiteral(const llvm::APSInt &value,
+                              const std::string &type) {
+    if (type == "native.CBool") {
+        return value.getBoolValue() ? "true" : "false";
+    }
+    int64_t number = value.isSigned()
+                         ? value.getExtValue()
+                         : static_cast<int64_t>(value.getZExtValue());
+    bool isLong = false;
+    std::string conversion;
+    if (type == "native.CChar" || type == "native.CSignedChar") {
+        number = static_cast<int8_t>(number);
+    } else if (type == "native.CUnsignedChar") {
+        conversion = ".toUByte";
+    } else if (type == "native.CUnsignedShort") {
+        conversion = ".toUShort";
+    } else if (type == "native.CUnsignedInt") {
+        number = static_cast<int32_t>(number);
+        conversion = ".toUInt";
+    } else if (type == "native.CLong" || type == "native.CLongLong") {
+        isLong = true;
+    } else if (type == "native.CUnsignedLong" ||
+               type == "native.CUnsignedLongLong") {
+        isLong = true;
+        conversion = ".toULong";
+    }
+    std::string literal = std::to_string(number);
+    if (isLong) {
+        literal += "L";
+    }
+    if (conversion.empty()) {
+        return literal;
+    }
+    if (number < 0) {
+        literal = "(" + literal + ")";
+    }
+    return literal + conversion;
+}
+
+/**
+ * @return the shortest decimal representation that is parsed back
+ *         to the same value
+ */
+std::string getFloatingLiteral(double value, bool isFloat) {
+    std::ostringstream s;
+    int maxPrecision = isFloat ? 9 : 17;
+    for (int precision = 1; precision <= maxPrecision; precision++) {
+        s.str("");
+        s << std::setprecision(precision) << value;
+        double parsed = std::strtod(s.str().c_str(), nullptr);
+        if (isFloat ? static_cast<float>(parsed) == static_cast<float>(value)
+                    : parsed == value) {
+            break;
+        }
+    }
+    return isFloat ? s.str() + "f" : s.str();
+}
+
+/**
+ * Adds literal defines for variables declared by DefineEvaluator.
+ */
+class DefineValuesConsumer : public clang::ASTConsumer {
+  public:
+    explicit DefineValuesConsumer(IR &ir) : ir(ir) {}
+
+    void HandleTranslationUnit(clang::ASTContext &context) override {
+        for (auto *decl : context.getTranslationUnitDecl()->decls()) {
+            auto *variable = llvm::dyn_cast<clang::VarDecl>(decl);
+            if (!variable || variable->isInvalidDecl() ||
+                !variable->getInit()) {
+                continue;
+            }
+            std::string name = variable->getName();
+            if (!startsWith(name, variablePrefix)) {
+                continue;
+            }
+            clang::Expr::EvalResult result;
+            if (!variable->getInit()->EvaluateAsRValue(result, context) ||
+                result.HasSideEffects) {
+                /* not a constant expression */
+                continue;
+            }
+            std::string type;
+            std::string literal;
+            clang::QualType qtpe = variable->getType().getCanonicalType();
+            if (result.Val.isInt()) {
+                type = getIntegerTypeName(context, qtpe);
+                if (!type.empty()) {
+                    literal = getIntegerLiteral(result.Val.getInt(), type);
+                }
+            } else if (result.Val.isFloat()) {
+                bool isFloat =
+                    qtpe->isSpecificBuiltinType(clang::BuiltinType::Float);
+                llvm::APFloat value = result.Val.getFloat();
+                bool losesInfo;
+                value.convert(llvm::APFloat::IEEEdouble(),
+                              llvm::APFloat::rmNearestTiesToEven, &losesInfo);
+                double number = value.convertToDouble();
+                if (std::isfinite(number)) {
+                    type = isFloat ? "native.CFloat" : "native.CDouble";
+                    literal = getFloatingLiteral(number, isFloat);
+                }
+            }
+            if (!type.empty()) {
+                ir.addLiteralDefine(
+                    name.substr(variablePrefix.size()), literal,
+                    ir.getTypeFactory().getPrimitiveType(type));
+            }
+        }
+    }
+
+  private:
+    IR &ir;
+};
+
+/**
+ * Enters declarations of variables for macros that may be constant
+ * expressions.
+ */
+class DefinesPragmaHandler : public clang::PragmaHandler {
+  public:
+    explicit DefinesPragmaHandler(IR &ir)
+        : clang::PragmaHandler(pragmaName), ir(ir) {}
+
+    void HandlePragma(clang::Preprocessor &pp,
+                      clang::PragmaIntroducerKind introducer,
+                      clang::Token &firstToken) override {
+        clang::Token token = firstToken;
+        while (token.isNot(clang::tok::eod)) {
+            pp.Lex(token);
+        }
+        if (ir.getPossibleConstantDefines().empty()) {
+            return;
+        }
+        /* errors are expected for macros that are not expressions.
+         * Diagnostics of the header are already reported at this point */
+        pp.getDiagnostics().setSuppressAllDiagnostics(true);
+
+        /* the include location makes the declarations not belong
+         * to the main file */
+        clang::SourceLocation location = firstToken.getLocation();
+        clang::FileID fileId = pp.getSourceManager().createFileID(
+            llvm::MemoryBuffer::getMemBufferCopy(getSource(),
+                                                 "<scala-native-bindgen>"),
+            clang::SrcMgr::C_User, 0, 0, location);
+        pp.EnterSourceFile(fileId, nullptr, location);
+    }
+
+  private:
+    IR &ir;
+
+    /**
+     * @return source that declares a variable per macro
+     */
+    std::string getSource() const {
+        std::stringstream s;
+        for (const auto &macroName : ir.getPossibleConstantDefines()) {
+            /* each declaration is on its own line and ends with semicolon,
+             * so parser recovers from errors before the next one */
+            s << "static const __typeof__((" << macroName << ")) "
+              << variablePrefix << macroName << " = (" << macroName
+              << ");\n";
+        }
+        return s.str();
+    }
+};
+
+} // namespace
+
+DefineEvaluator::DefineEvaluator(IR &ir) : ir(ir) {}
+
+std::unique_ptr<clang::ASTConsumer>
+DefineEvaluator::attach(clang::CompilerInstance &compiler) {
+    /* the preprocessor owns pragma handlers */
+    compiler.getPreprocessor().AddPragmaHandler(pragmaNamespace,
+                                                new DefinesPragmaHandler(ir));
+    return std::unique_ptr<clang::ASTConsumer>(new DefineValuesConsumer(ir));
+}
+
+std::string DefineEvaluator::getPragma() {
+    return "#pragma " + pragmaNamespace + " " + pragmaName;
+}
@@ -0,0 +1,50 @@
+#ifndef SCALA_NATIVE_BINDGEN_DEFINEEVALUATOR_H
+#define SCALA_NATIVE_BINDGEN_DEFINEEVALUATOR_H
+
+#include "../ir/IR.h"
+#include <clang/AST/ASTConsumer.h>
+#include <clang/Frontend/CompilerInstance.h>
+
+/**
+ * Computes values of object-like macros that are constant expressions,
+ * for example `(1u << 4)`, `(FLAG_A | FLAG_B)`, `((int)0x7f)` or
+ * `sizeof(struct hdr)`.
+ *
+ * DefineFinder saves names of such macros in IR. The header is parsed with
+ * one more line at the end, see getPragma. When the preprocessor reaches
+ * the pragma, all macros of the header are known and a declaration per
+ * macro is entered in the same compiler instance:
+ * @code
+ * static const __typeof__((NAME)) __scala_native_bindgen_define_NAME = (NAME);
+ * @endcode
+ * Initializers are computed by clang constant evaluator and macros with
+ * integer or floating point values are added to IR as literal defines.
+ * Type of a literal define has the width and signedness of the C
+ * expression.
+ *
+ * Macros that are not constant expressions are skipped silently,
+ * diagnostics are suppressed after the pragma.
+ */
+class DefineEvaluator {
+  public:
+    explicit DefineEvaluator(IR &ir);
+
+    /**
+     * Registers handler of the pragma on the preprocessor of the compiler.
+     *
+     * @return consumer that adds literal defines to IR when
+     *         the translation unit is parsed
+     */
+    std::unique_ptr<clang::ASTConsumer>
+    attach(clang::CompilerInstance &compiler);
+
+    /**
+     * @return line that should be appended to the header
+     */
+    static std::string getPragma();
+
+  private:
+    IR &ir;
+};
+
+#endif // SCALA_NATIVE_BINDGEN_DEFINEEVALUATOR_H
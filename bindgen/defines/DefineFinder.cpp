@@ -10,23 +10,33 @@ DefineFinder::DefineFinder(IR &ir, const clang::CompilerInstance &compiler,
 
 void DefineFinder::MacroDefined(const clang::Token &macroNameTok,
                                 const clang::MacroDirective *md) {
+    const clang::MacroDirective *previous = md->getPrevious();
+    if (previous && previous->isDefined()) {
+        /* the macro is redefined */
+        invalidateExpansions(previous->getMacroInfo());
+    } else {
+        invalidateExpansions(macroNameTok.getIdentifierInfo());
+    }
     clang::SourceManager &sm = compiler.getSourceManager();
     if (!sm.isInMainFile(md->getLocation())) {
         /* include defines only from the original header */
         return;
     }
-    if (sm.isWrittenInMainFile(macroNameTok.getLocation()) && md->isDefined() &&
-        !md->getMacroInfo()->isFunctionLike()) {
-        /* save defines only from the given header.
-         *
-         * Ignore function-like definitions because they usually are meaningful
-         * only inside C functions. */
+    if (sm.isWrittenInMainFile(macroNameTok.getLocation()) && md->isDefined()) {
+        /* save defines only from the given header */
+        std::string macroName = macroNameTok.getIdentifierInfo()->getName();
+        if (md->getMacroInfo()->isFunctionLike()) {
+            /* translated to inline function if the body is
+             * an integer expression */
+            addFunctionDefine(macroName, *md->getMacroInfo());
+            return;
+        }
 
-        std::vector<clang::Token> *tokens = expandDefine(*md);
+        llvm::Optional<llvm::ArrayRef<clang::Token>> tokens =
+            expandDefine(*md->getMacroInfo());
         if (!tokens) { // there was function-like macro
             return;
         }
-        std::string macroName = macroNameTok.getIdentifierInfo()->getName();
 
         if (tokens->size() == 1 &&
             (*tokens)[0].getKind() == clang::tok::numeric_constant) {
@@ -48,45 +58,189 @@ void DefineFinder::MacroDefined(const clang::Token &macroNameTok,
                                 stringToken.getLength());
             ir.addLiteralDefine(
                 macroName, "c" + literal,
-                std::make_shared<PrimitiveType>("native.CString"));
+                ir.getTypeFactory().getPrimitiveType("native.CString"));
         } else if (tokens->size() == 1 &&
                    (*tokens)[0].getKind() == clang::tok::identifier) {
             // token might be a variable
             std::string varName = (*tokens)[0].getIdentifierInfo()->getName();
             ir.addPossibleVarDefine(macroName, varName);
+        } else if (isPossibleConstantExpression(*tokens)) {
+            /* value is computed by DefineEvaluator */
+            ir.addPossibleConstantDefine(macroName);
         }
-        delete tokens;
     }
 }
 
-/**
- * @return array of tokens. Non of the returned tokens is a macro.
- */
-std::vector<clang::Token> *
-DefineFinder::expandDefine(const clang::MacroDirective &md) {
-    auto *expandedTokens = new std::vector<clang::Token>();
-    clang::ArrayRef<clang::Token> tokens = md.getMacroInfo()->tokens();
-    for (const auto &token : tokens) {
+void DefineFinder::addFunctionDefine(const std::string &macroName,
+                                     const clang::MacroInfo &macroInfo) {
+    std::vector<std::string> parameters;
+    for (const clang::IdentifierInfo *parameter : macroInfo.params()) {
+        parameters.push_back(parameter->getName().str());
+    }
+    std::vector<MacroToken> tokens;
+    for (const auto &token : macroInfo.tokens()) {
+        if (token.isAnyIdentifier() &&
+            macroInfo.getParameterNum(token.getIdentifierInfo()) >= 0) {
+            tokens.emplace_back(MacroToken::Kind::Parameter,
+                                token.getIdentifierInfo()->getName().str());
+            continue;
+        }
+        if (isMacro(token)) {
+            const clang::MacroInfo *tokenMacroInfo =
+                pp.getMacroInfo(token.getIdentifierInfo());
+            llvm::Optional<llvm::ArrayRef<clang::Token>> expandedTokens;
+            if (!tokenMacroInfo->isFunctionLike()) {
+                expandedTokens = expandDefine(*tokenMacroInfo);
+            }
+            if (expandedTokens) {
+                for (const auto &expandedToken : *expandedTokens) {
+                    tokens.push_back(getMacroToken(expandedToken));
+                }
+                continue;
+            }
+        }
+        tokens.push_back(getMacroToken(token));
+    }
+    ir.addFunctionDefine(macroName, std::move(parameters), std::move(tokens),
+                         macroInfo.isVariadic());
+}
+
+MacroToken DefineFinder::getMacroToken(const clang::Token &token) {
+    if (token.isAnyIdentifier()) {
+        return MacroToken(MacroToken::Kind::Identifier,
+                          token.getIdentifierInfo()->getName().str());
+    }
+    if (token.is(clang::tok::numeric_constant)) {
+        std::string literal(token.getLiteralData(), token.getLength());
+        std::string scalaLiteral = getIntegerLiteral(literal, token);
+        if (!scalaLiteral.empty()) {
+            return MacroToken(MacroToken::Kind::Integer, scalaLiteral);
+        }
+    } else if (const char *punctuator =
+                   clang::tok::getPunctuatorSpelling(token.getKind())) {
+        return MacroToken(MacroToken::Kind::Punctuator, punctuator);
+    }
+    return MacroToken(MacroToken::Kind::Other, pp.getSpelling(token));
+}
+
+std::string DefineFinder::getIntegerLiteral(const std::string &literal,
+                                            const clang::Token &token) {
+    clang::NumericLiteralParser parser(literal, token.getLocation(), pp);
+    if (parser.hadError || !parser.isIntegerLiteral() || parser.isUnsigned) {
+        return "";
+    }
+    if (!parser.isLong && !parser.isLongLong &&
+        integerFitsIntoType<int, uint>(parser, true)) {
+        return getDecimalLiteral(parser);
+    }
+    if (parser.getRadix() != 10 && !parser.isLong && !parser.isLongLong &&
+        integerFitsIntoType<uint, uint>(parser, true)) {
+        /* the literal has unsigned int type */
+        return "";
+    }
+    if (integerFitsIntoType<long, unsigned long>(parser, true)) {
+        return getDecimalLiteral(parser) + "L";
+    }
+    return "";
+}
+
+llvm::Optional<llvm::ArrayRef<clang::Token>>
+DefineFinder::expandDefine(const clang::MacroInfo &macroInfo) {
+    auto it = expansions.find(&macroInfo);
+    if (it != expansions.end()) {
+        return it->second;
+    }
+    /* the macro is not expanded if it is reached again during
+     * its own expansion */
+    expansions[&macroInfo] = llvm::None;
+
+    llvm::SmallVector<clang::Token, 16> expandedTokens;
+    for (const auto &token : macroInfo.tokens()) {
         if (isMacro(token)) {
-            if (isFunctionLikeMacro(token)) {
+            const clang::MacroInfo *tokenMacroInfo =
+                pp.getMacroInfo(token.getIdentifierInfo());
+            if (tokenMacroInfo->isFunctionLike()) {
                 /* function-like macros are unsupported */
-                return nullptr;
+                return llvm::None;
             }
-            std::vector<clang::Token> *newTokens = expandDefine(
-                *pp.getLocalMacroDirective(token.getIdentifierInfo()));
+            llvm::Optional<llvm::ArrayRef<clang::Token>> newTokens =
+                expandDefine(*tokenMacroInfo);
             if (!newTokens) {
-                delete expandedTokens;
-                return nullptr;
-            }
-            for (const auto &newToken : *newTokens) {
-                (*expandedTokens).push_back(newToken);
+                return llvm::None;
             }
-            delete newTokens;
+            expandedTokens.append(newTokens->begin(), newTokens->end());
         } else {
-            (*expandedTokens).push_back(token);
+            if (token.isAnyIdentifier()) {
+                unexpandedIdentifiers.insert(token.getIdentifierInfo());
+            }
+            expandedTokens.push_back(token);
         }
     }
-    return expandedTokens;
+
+    llvm::ArrayRef<clang::Token> result;
+    if (!expandedTokens.empty()) {
+        auto *data =
+            tokensAllocator.Allocate<clang::Token>(expandedTokens.size());
+        std::uninitialized_copy(expandedTokens.begin(), expandedTokens.end(),
+                                data);
+        result = llvm::ArrayRef<clang::Token>(data, expandedTokens.size());
+    }
+    expansions[&macroInfo] = result;
+    return result;
+}
+
+void DefineFinder::invalidateExpansions(const clang::MacroInfo *macroInfo) {
+    /* cached expansions depend on the macro only if the macro
+     * was expanded itself */
+    if (macroInfo && expansions.count(macroInfo)) {
+        clearExpansions();
+    }
+}
+
+void DefineFinder::invalidateExpansions(
+    const clang::IdentifierInfo *macroName) {
+    /* the identifier was not expanded because it was not a macro */
+    if (unexpandedIdentifiers.count(macroName)) {
+        clearExpansions();
+    }
+}
+
+void DefineFinder::clearExpansions() {
+    expansions.clear();
+    unexpandedIdentifiers.clear();
+}
+
+bool DefineFinder::isPossibleConstantExpression(
+    llvm::ArrayRef<clang::Token> tokens) {
+    if (tokens.empty()) {
+        return false;
+    }
+    int depth = 0;
+    for (const auto &token : tokens) {
+        switch (token.getKind()) {
+        case clang::tok::l_paren:
+        case clang::tok::l_square:
+            depth++;
+            break;
+        case clang::tok::r_paren:
+        case clang::tok::r_square:
+            if (--depth < 0) {
+                return false;
+            }
+            break;
+        case clang::tok::l_brace:
+        case clang::tok::r_brace:
+        case clang::tok::semi:
+        case clang::tok::hash:
+        case clang::tok::hashhash:
+        case clang::tok::kw___attribute:
+            /* statements, initializers and attributes */
+            return false;
+        default:
+            break;
+        }
+    }
+    return depth == 0;
 }
 
 bool DefineFinder::isMacro(const clang::Token &token) {
@@ -94,12 +248,6 @@ bool DefineFinder::isMacro(const clang::Token &token) {
            token.getIdentifierInfo()->hasMacroDefinition();
 }
 
-bool DefineFinder::isFunctionLikeMacro(const clang::Token &token) {
-    clang::MacroDirective *md =
-        pp.getLocalMacroDirective(token.getIdentifierInfo());
-    return md->getMacroInfo()->isFunctionLike();
-}
-
 void DefineFinder::MacroUndefined(const clang::Token &macroNameTok,
                                   const clang::MacroDefinition &md,
                                   const clang::MacroDirective *undef) {
@@ -107,9 +255,10 @@ void DefineFinder::MacroUndefined(const clang::Token &macroNameTok,
         /* macro was not defined */
         return;
     }
+    invalidateExpansions(md.getMacroInfo());
     clang::SourceManager &sm = compiler.getSourceManager();
     if (sm.isWrittenInMainFile(macroNameTok.getLocation()) &&
-        md.getMacroInfo() && !md.getMacroInfo()->isFunctionLike()) {
+        md.getMacroInfo()) {
         std::string macroName = macroNameTok.getIdentifierInfo()->getName();
         ir.removeDefine(macroName);
     }
@@ -162,7 +311,7 @@ void DefineFinder::addNumericConstantDefine(const std::string &macroName,
             scalaLiteral = "-" + scalaLiteral;
         }
         ir.addLiteralDefine(macroName, scalaLiteral,
-                            std::make_shared<PrimitiveType>(type));
+                            ir.getTypeFactory().getPrimitiveType(type));
     }
 }
 
@@ -176,9 +325,10 @@ DefineFinder::getTypeOfIntegerLiteral(const clang::NumericLiteralParser &parser,
     } else if (integerFitsIntoType<long, unsigned long>(parser, positive)) {
         return "native.CLong";
     } else {
-        llvm::errs() << "Warning: integer value does not fit into 8 bytes: "
-                     << literal << "\n";
-        llvm::errs().flush();
+        ir.getDiagnostics()
+            << "Warning: integer value does not fit into 8 bytes: " << literal
+            << "\n";
+        ir.getDiagnostics().flush();
         /**
          * `long long` value has mostly the same size as `long`.
          * Moreover in Scala Native the type is represented as `Long`:
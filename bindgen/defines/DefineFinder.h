@@ -5,6 +5,10 @@
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Lex/LiteralSupport.h>
 #include <clang/Lex/Preprocessor.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/Optional.h>
+#include <llvm/Support/Allocator.h>
 
 class DefineFinder : public clang::PPCallbacks {
   public:
@@ -22,12 +26,33 @@ class DefineFinder : public clang::PPCallbacks {
     IR &ir;
     const clang::CompilerInstance &compiler;
     clang::Preprocessor &pp;
+    /* memory for expanded tokens */
+    llvm::BumpPtrAllocator tokensAllocator;
+    /* expanded tokens of object-like macros, see expandDefine */
+    llvm::DenseMap<const clang::MacroInfo *,
+                   llvm::Optional<llvm::ArrayRef<clang::Token>>>
+        expansions;
+    /* identifiers in cached expansions that were not macros when the
+     * expansions were made */
+    llvm::DenseSet<const clang::IdentifierInfo *> unexpandedIdentifiers;
 
     void addNumericConstantDefine(const std::string &macroName,
                                   std::string literal,
                                   const clang::Token &token,
                                   bool positive = true);
 
+    void addFunctionDefine(const std::string &macroName,
+                           const clang::MacroInfo &macroInfo);
+
+    MacroToken getMacroToken(const clang::Token &token);
+
+    /**
+     * @return Scala literal for signed integer literal that fits into
+     *         int or long, otherwise empty string
+     */
+    std::string getIntegerLiteral(const std::string &literal,
+                                  const clang::Token &token);
+
     /**
      * Check if the number fits into int or long variable.
      *
@@ -37,11 +62,39 @@ class DefineFinder : public clang::PPCallbacks {
     getTypeOfIntegerLiteral(const clang::NumericLiteralParser &parser,
                             const std::string &literal, bool positive);
 
-    std::vector<clang::Token> *expandDefine(const clang::MacroDirective &md);
+    /**
+     * Expansions are cached until one of expanded macros is redefined or
+     * undefined, or until an identifier in them is defined as a macro.
+     *
+     * @return expanded tokens. None of the returned tokens is a macro.
+     *         llvm::None if the macro uses function-like macros or refers
+     *         to itself.
+     */
+    llvm::Optional<llvm::ArrayRef<clang::Token>>
+    expandDefine(const clang::MacroInfo &macroInfo);
+
+    /**
+     * Remove cached expansions if they may depend on the macro.
+     */
+    void invalidateExpansions(const clang::MacroInfo *macroInfo);
+
+    /**
+     * Remove cached expansions if they contain the name of a new macro.
+     */
+    void invalidateExpansions(const clang::IdentifierInfo *macroName);
+
+    void clearExpansions();
 
     bool isMacro(const clang::Token &token);
 
-    bool isFunctionLikeMacro(const clang::Token &token);
+    /**
+     * Filters out token sequences that cannot be a C expression, so that
+     * a broken macro does not break parsing of other macros
+     * in DefineEvaluator.
+     *
+     * @return true if expanded tokens may form a constant expression
+     */
+    bool isPossibleConstantExpression(llvm::ArrayRef<clang::Token> tokens);
 
     /**
      * @return true if number contained in parser fits into int type
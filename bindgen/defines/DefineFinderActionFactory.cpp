@@ -1,8 +0,0 @@
-#include "DefineFinderActionFactory.h"
-#include "DefineFinderAction.h"
-
-DefineFinderActionFactory::DefineFinderActionFactory(IR &ir) : ir(ir) {}
-
-clang::FrontendAction *DefineFinderActionFactory::create() {
-    return new DefineFinderAction(ir);
-}
@@ -0,0 +1,5 @@
+#include "Arena.h"
+
+std::size_t Arena::getBytesUsed() const {
+    return allocator.getBytesAllocated();
+}
@@ -0,0 +1,81 @@
+#ifndef SCALA_NATIVE_BINDGEN_ARENA_H
+#define SCALA_NATIVE_BINDGEN_ARENA_H
+
+#include <llvm/Support/Allocator.h>
+#include <memory>
+
+/**
+ * Bump-pointer allocator for nodes of intermediate representation.
+ *
+ * Memory is released only when the arena is destroyed, therefore the arena
+ * must outlive all nodes that were created by it.
+ * The arena is not thread-safe, each IR has its own arena.
+ *
+ * All nodes of an IR are created in its arena, including copies of types
+ * that are made while bindings are generated (see TypeFactory::getArena).
+ * Nodes are still owned through std::shared_ptr, the arena only provides
+ * their memory. Traversals take nodes by const reference or raw pointer so
+ * reference counters are updated only when an edge of the IR is created.
+ */
+class Arena {
+  public:
+    /**
+     * STL allocator that takes memory from the arena.
+     * Deallocation does nothing.
+     */
+    template <typename T> class Allocator {
+      public:
+        using value_type = T;
+
+        explicit Allocator(Arena &arena) : arena(&arena) {}
+
+        template <typename U>
+        Allocator(const Allocator<U> &other) : arena(other.arena) {}
+
+        T *allocate(std::size_t n) {
+            return static_cast<T *>(
+                arena->allocator.Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *p, std::size_t n) {}
+
+        template <typename U> bool operator==(const Allocator<U> &other) const {
+            return arena == other.arena;
+        }
+
+        template <typename U> bool operator!=(const Allocator<U> &other) const {
+            return arena != other.arena;
+        }
+
+      private:
+        template <typename U> friend class Allocator;
+
+        Arena *arena;
+    };
+
+    Arena() = default;
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * Create a node in the arena.
+     * The node and its reference counter are placed in one allocation.
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make(Args &&... args) {
+        return std::allocate_shared<T>(Allocator<T>(*this),
+                                       std::forward<Args>(args)...);
+    }
+
+    /**
+     * @return number of bytes allocated in the arena
+     */
+    std::size_t getBytesUsed() const;
+
+  private:
+    llvm::BumpPtrAllocator allocator;
+};
+
+#endif // SCALA_NATIVE_BINDGEN_ARENA_H
@@ -10,8 +10,9 @@ int64_t Enumerator::getValue() { return value; }
 Enum::Enum(std::string name, std::string type,
            std::vector<Enumerator> enumerators,
            std::shared_ptr<Location> location)
-    : PrimitiveType(std::move(type)), LocatableType(std::move(location)),
-      name(std::move(name)), enumerators(std::move(enumerators)) {}
+    : Type(Kind::Enum), PrimitiveType(std::move(type)),
+      LocatableType(std::move(location)), name(std::move(name)),
+      enumerators(std::move(enumerators)) {}
 
 std::string Enum::getEnumerators() const {
     std::stringstream s;
@@ -40,10 +41,15 @@ std::string Enum::getTypeCastSuffix() const {
 }
 
 std::string Enum::str(const LocationManager &locationManager) const {
+    if (const std::string *cached = getCachedStr(locationManager)) {
+        return *cached;
+    }
     if (locationManager.isImported(*location)) {
-        return locationManager.getImportedType(*location, getTypeAlias());
+        return setCachedStr(
+            locationManager,
+            locationManager.getImportedType(*location, getTypeAlias()));
     }
-    return getTypeAlias();
+    return setCachedStr(locationManager, getTypeAlias());
 }
 
 std::string Enum::getTypeAlias() const { return "enum_" + name; }
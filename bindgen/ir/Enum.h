@@ -25,6 +25,10 @@ class Enum : public PrimitiveType, public LocatableType {
          std::vector<Enumerator> enumerators,
          std::shared_ptr<Location> location);
 
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::Enum;
+    }
+
     /**
      * @return a string that contains all enumerators.
      *         If enum is not anonymous then enumerators are inside an object
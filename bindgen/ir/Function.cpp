@@ -16,8 +16,9 @@ Function::Function(const std::string &name,
 std::string
 Function::getDefinition(const LocationManager &locationManager) const {
     std::stringstream s;
-    if (scalaName != name) {
-        s << "  @native.link(\"" << name << "\")\n";
+    std::string linkName = shim.empty() ? name : getShimName();
+    if (scalaName != linkName) {
+        s << "  @native.link(\"" << linkName << "\")\n";
     }
     s << "  def " << handleReservedWords(scalaName) << "(";
     std::string sep = "";
@@ -35,9 +36,9 @@ Function::getDefinition(const LocationManager &locationManager) const {
     return s.str();
 }
 
-bool Function::usesType(
-    std::shared_ptr<const Type> type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool Function::usesType(const std::shared_ptr<const Type> &type,
+                        bool stopOnTypeDefs,
+                        std::vector<const Type *> &visitedTypes) const {
     visitedTypes.clear();
     if (*retType == *type ||
         retType.get()->usesType(type, stopOnTypeDefs, visitedTypes)) {
@@ -54,6 +55,18 @@ bool Function::usesType(
     return false;
 }
 
+void Function::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes) const {
+    std::vector<const Type *> visitedTypes;
+    usedTypes.push_back(retType);
+    retType->collectUsedTypes(usedTypes, visitedTypes);
+    for (const auto &parameter : parameters) {
+        visitedTypes.clear();
+        usedTypes.push_back(parameter->getType());
+        parameter->getType()->collectUsedTypes(usedTypes, visitedTypes);
+    }
+}
+
 std::string Function::getName() const { return name; }
 
 std::string Function::getVarargsParameterName() const {
@@ -95,3 +108,11 @@ bool Function::isLegalScalaNativeFunction() const {
     }
     return true;
 }
+
+void Function::setShim(std::string shim) { this->shim = std::move(shim); }
+
+std::string Function::getShim() const { return shim; }
+
+std::string Function::getShimName() const {
+    return "scala_native_bindgen_" + name;
+}
@@ -20,8 +20,15 @@ class Function {
 
     std::string getDefinition(const LocationManager &locationManager) const;
 
-    bool usesType(std::shared_ptr<const Type> type, bool stopOnTypeDefs,
-                  std::vector<std::shared_ptr<const Type>> &visitedTypes) const;
+    bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
+                  std::vector<const Type *> &visitedTypes) const;
+
+    /**
+     * Add types that are used by the function to usedTypes.
+     * @see Type::collectUsedTypes
+     */
+    void
+    collectUsedTypes(std::vector<std::shared_ptr<const Type>> &usedTypes) const;
 
     std::string getName() const;
 
@@ -33,6 +40,26 @@ class Function {
      */
     bool isLegalScalaNativeFunction() const;
 
+    /**
+     * Make Scala function call C wrapper instead of the function itself.
+     * It is used for functions that do not have linkable symbol,
+     * for example `static inline` functions, and for functions that pass
+     * structs by value. Parameters of such functions are pointers.
+     *
+     * @param shim C definition of the wrapper that is named getShimName()
+     */
+    void setShim(std::string shim);
+
+    /**
+     * @return C definition of the wrapper or empty string
+     */
+    std::string getShim() const;
+
+    /**
+     * @return name of C wrapper of the function
+     */
+    std::string getShimName() const;
+
   private:
     std::string getVarargsParameterName() const;
 
@@ -43,6 +70,7 @@ class Function {
     std::vector<std::shared_ptr<Parameter>> parameters;
     std::shared_ptr<const Type> retType;
     bool isVariadic;
+    std::string shim; // may be empty
 };
 
 #endif // SCALA_NATIVE_BINDGEN_FUNCTION_H
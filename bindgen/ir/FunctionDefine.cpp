@@ -0,0 +1,549 @@
+#include "FunctionDefine.h"
+#include "../Utils.h"
+#include "types/PrimitiveType.h"
+#include <unordered_map>
+
+MacroToken::MacroToken(Kind kind, std::string spelling)
+    : kind(kind), spelling(std::move(spelling)) {}
+
+namespace {
+
+/**
+ * Scala expression and its type.
+ */
+struct Expression {
+    enum class Type { Int, Long, Boolean, Pointer };
+
+    std::string code;
+    Type type;
+    /* name of parameter for Pointer expressions */
+    std::string parameter;
+};
+
+/**
+ * Field that is read through a pointer parameter.
+ */
+struct FieldAccess {
+    std::string getter;
+    std::string type; // name of primitive type
+};
+
+struct MacroParameter {
+    std::string scalaName;
+    bool isPointer = false;
+    /* accessed fields of pointer parameter by name */
+    std::unordered_map<std::string, FieldAccess> fields;
+};
+
+/**
+ * @return expression without outer parentheses
+ */
+std::string stripParentheses(const std::string &code) {
+    if (code.empty() || code.front() != '(' || code.back() != ')') {
+        return code;
+    }
+    int depth = 0;
+    for (size_t i = 0; i < code.size() - 1; i++) {
+        if (code[i] == '(') {
+            depth++;
+        } else if (code[i] == ')') {
+            depth--;
+        }
+        if (depth == 0) {
+            /* first parenthesis is closed before the end */
+            return code;
+        }
+    }
+    return code.substr(1, code.size() - 2);
+}
+
+/**
+ * @return binary operator precedence or -1 if the token is not
+ *         a binary operator
+ */
+int getPrecedence(const MacroToken &token) {
+    if (token.kind != MacroToken::Kind::Punctuator) {
+        return -1;
+    }
+    static const std::unordered_map<std::string, int> precedences = {
+        {"||", 1}, {"&&", 2}, {"|", 3},  {"^", 4},  {"&", 5},
+        {"==", 6}, {"!=", 6}, {"<", 7},  {"<=", 7}, {">", 7},
+        {">=", 7}, {"<<", 8}, {">>", 8}, {"+", 9},  {"-", 9},
+        {"*", 10}, {"/", 10}, {"%", 10}};
+    auto it = precedences.find(token.spelling);
+    return it == precedences.end() ? -1 : it->second;
+}
+
+/**
+ * Recursive descent parser that translates C integer expression to Scala.
+ *
+ * Comparisons and logical operators produce Boolean values, Boolean values
+ * are converted back to 0 or 1 when they are used in arithmetic.
+ */
+class ExpressionTranslator {
+  public:
+    ExpressionTranslator(
+        const std::vector<MacroToken> &tokens,
+        const std::unordered_map<std::string, MacroParameter> &parameters)
+        : tokens(tokens), parameters(parameters) {}
+
+    /**
+     * @return false if tokens are not an integer expression,
+     *         see getError
+     */
+    bool translate(Expression &result) {
+        if (!parseConditional(result)) {
+            return false;
+        }
+        if (position != tokens.size()) {
+            return fail();
+        }
+        return true;
+    }
+
+    std::string getError() const { return error; }
+
+  private:
+    const std::vector<MacroToken> &tokens;
+    const std::unordered_map<std::string, MacroParameter> &parameters;
+    size_t position = 0;
+    std::string error;
+
+    bool isPunctuator(const std::string &spelling) const {
+        return position < tokens.size() &&
+               tokens[position].kind == MacroToken::Kind::Punctuator &&
+               tokens[position].spelling == spelling;
+    }
+
+    /**
+     * Sets error for the current token.
+     */
+    bool fail() {
+        if (position < tokens.size()) {
+            const MacroToken &token = tokens[position];
+            if (token.kind == MacroToken::Kind::Identifier) {
+                error = "it references `" + token.spelling + "`";
+                return false;
+            }
+            if (token.kind == MacroToken::Kind::Other) {
+                error = "it contains `" + token.spelling + "`";
+                return false;
+            }
+        }
+        error = "it is not an integer expression";
+        return false;
+    }
+
+    bool fail(const std::string &message) {
+        error = message;
+        return false;
+    }
+
+    bool toNumber(Expression &expression) {
+        if (expression.type == Expression::Type::Pointer) {
+            return fail("parameter `" + expression.parameter +
+                        "` is used as a number");
+        }
+        if (expression.type == Expression::Type::Boolean) {
+            expression.code = "(if (" + stripParentheses(expression.code) +
+                              ") 1 else 0)";
+            expression.type = Expression::Type::Int;
+        }
+        return true;
+    }
+
+    bool toBoolean(Expression &expression) {
+        if (!toNumber(expression)) {
+            return false;
+        }
+        expression.code = "(" + expression.code + " != 0)";
+        expression.type = Expression::Type::Boolean;
+        return true;
+    }
+
+    static Expression::Type widen(const Expression &left,
+                                  const Expression &right) {
+        if (left.type == Expression::Type::Long ||
+            right.type == Expression::Type::Long) {
+            return Expression::Type::Long;
+        }
+        return Expression::Type::Int;
+    }
+
+    bool parseConditional(Expression &result) {
+        if (!parseBinary(1, result)) {
+            return false;
+        }
+        if (!isPunctuator("?")) {
+            return true;
+        }
+        position++;
+        Expression thenExpression;
+        if (!parseConditional(thenExpression)) {
+            return false;
+        }
+        if (!isPunctuator(":")) {
+            return fail();
+        }
+        position++;
+        Expression elseExpression;
+        if (!parseConditional(elseExpression)) {
+            return false;
+        }
+        if (result.type != Expression::Type::Boolean && !toBoolean(result)) {
+            return false;
+        }
+        if (thenExpression.type != Expression::Type::Boolean ||
+            elseExpression.type != Expression::Type::Boolean) {
+            if (!toNumber(thenExpression) || !toNumber(elseExpression)) {
+                return false;
+            }
+            Expression::Type type = widen(thenExpression, elseExpression);
+            for (Expression *branch : {&thenExpression, &elseExpression}) {
+                if (branch->type != type) {
+                    branch->code += ".toLong";
+                    branch->type = type;
+                }
+            }
+        }
+        result.code = "(if (" + stripParentheses(result.code) + ") " +
+                      thenExpression.code + " else " + elseExpression.code +
+                      ")";
+        result.type = thenExpression.type;
+        return true;
+    }
+
+    bool parseBinary(int minPrecedence, Expression &result) {
+        if (!parseUnary(result)) {
+            return false;
+        }
+        while (position < tokens.size()) {
+            int precedence = getPrecedence(tokens[position]);
+            if (precedence < minPrecedence) {
+                return true;
+            }
+            std::string op = tokens[position].spelling;
+            position++;
+            Expression right;
+            if (!parseBinary(precedence + 1, right)) {
+                return false;
+            }
+            if (!applyBinary(op, result, right)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool applyBinary(const std::string &op, Expression &left,
+                     Expression &right) {
+        Expression::Type type;
+        if (op == "&&" || op == "||") {
+            if ((left.type != Expression::Type::Boolean && !toBoolean(left)) ||
+                (right.type != Expression::Type::Boolean &&
+                 !toBoolean(right))) {
+                return false;
+            }
+            type = Expression::Type::Boolean;
+        } else if ((op == "==" || op == "!=") &&
+                   left.type == Expression::Type::Boolean &&
+                   right.type == Expression::Type::Boolean) {
+            type = Expression::Type::Boolean;
+        } else {
+            if (!toNumber(left) || !toNumber(right)) {
+                return false;
+            }
+            if (op == "==" || op == "!=" || op == "<" || op == "<=" ||
+                op == ">" || op == ">=") {
+                type = Expression::Type::Boolean;
+            } else if (op == "<<" || op == ">>") {
+                /* type of shift is the type of left operand */
+                type = left.type;
+            } else {
+                type = widen(left, right);
+            }
+        }
+        left.code = "(" + left.code + " " + op + " " + right.code + ")";
+        left.type = type;
+        return true;
+    }
+
+    bool parseUnary(Expression &result) {
+        if (isPunctuator("-") || isPunctuator("~") || isPunctuator("!") ||
+            isPunctuator("+")) {
+            std::string op = tokens[position].spelling;
+            position++;
+            if (!parseUnary(result)) {
+                return false;
+            }
+            if (op == "!") {
+                if (result.type != Expression::Type::Boolean &&
+                    !toBoolean(result)) {
+                    return false;
+                }
+                result.code = "(!" + result.code + ")";
+                return true;
+            }
+            if (!toNumber(result)) {
+                return false;
+            }
+            if (op != "+") {
+                result.code = "(" + op + result.code + ")";
+            }
+            return true;
+        }
+        return parsePostfix(result);
+    }
+
+    bool parsePostfix(Expression &result) {
+        if (!parsePrimary(result)) {
+            return false;
+        }
+        while (isPunctuator("->")) {
+            position++;
+            if (result.type != Expression::Type::Pointer ||
+                position >= tokens.size()) {
+                return fail();
+            }
+            const MacroParameter &parameter = parameters.at(result.parameter);
+            const FieldAccess &field =
+                parameter.fields.at(tokens[position].spelling);
+            position++;
+            result.code = parameter.scalaName + "." + field.getter;
+            if (field.type == "native.CInt") {
+                result.type = Expression::Type::Int;
+            } else if (field.type == "native.CLong" ||
+                       field.type == "native.CLongLong") {
+                result.type = Expression::Type::Long;
+            } else if (field.type == "native.CBool") {
+                result.type = Expression::Type::Boolean;
+            } else {
+                /* integer promotion of smaller types */
+                result.code += ".toInt";
+                result.type = Expression::Type::Int;
+            }
+        }
+        return true;
+    }
+
+    bool parsePrimary(Expression &result) {
+        if (position >= tokens.size()) {
+            return fail();
+        }
+        const MacroToken &token = tokens[position];
+        switch (token.kind) {
+        case MacroToken::Kind::Integer:
+            position++;
+            result.code = token.spelling;
+            result.type = endsWith(token.spelling, "L")
+                              ? Expression::Type::Long
+                              : Expression::Type::Int;
+            return true;
+        case MacroToken::Kind::Parameter: {
+            position++;
+            const MacroParameter &parameter = parameters.at(token.spelling);
+            result.code = parameter.scalaName;
+            result.parameter = token.spelling;
+            result.type = parameter.isPointer ? Expression::Type::Pointer
+                                              : Expression::Type::Long;
+            return true;
+        }
+        case MacroToken::Kind::Punctuator:
+            if (token.spelling == "(") {
+                position++;
+                if (!parseConditional(result)) {
+                    return false;
+                }
+                if (!isPunctuator(")")) {
+                    return fail();
+                }
+                position++;
+                return true;
+            }
+            return fail();
+        default:
+            return fail();
+        }
+    }
+};
+
+/**
+ * @return name of primitive type that the type is an alias for or empty
+ *         string
+ */
+std::string getPrimitiveTypeName(std::shared_ptr<const Type> type) {
+    while (type) {
+        if (auto *primitiveType = dyn_cast<PrimitiveType>(type.get())) {
+            return primitiveType->getType();
+        }
+        auto *typeDef = dyn_cast<TypeDef>(type.get());
+        if (!typeDef) {
+            break;
+        }
+        type = typeDef->getType();
+    }
+    return "";
+}
+
+} // namespace
+
+FunctionDefine::FunctionDefine(std::string name,
+                               std::vector<std::string> parameters,
+                               std::vector<MacroToken> tokens, bool isVariadic)
+    : Define(std::move(name)), parameters(std::move(parameters)),
+      tokens(std::move(tokens)), isVariadic(isVariadic) {}
+
+bool FunctionDefine::translate(
+    const std::vector<std::pair<std::shared_ptr<const Struct>,
+                                std::shared_ptr<const TypeDef>>> &structs,
+    const LocationManager &locationManager) {
+    if (isVariadic) {
+        skipReason = "it is variadic";
+        return false;
+    }
+
+    /* parameter is a pointer if it is followed by `->` */
+    std::unordered_map<std::string, MacroParameter> parameterInfos;
+    std::vector<std::string> fieldNames;
+    for (const auto &parameter : parameters) {
+        MacroParameter info;
+        info.scalaName = handleReservedWords(parameter);
+        bool isNumber = false;
+        fieldNames.clear();
+        for (size_t i = 0; i < tokens.size(); i++) {
+            if (tokens[i].kind != MacroToken::Kind::Parameter ||
+                tokens[i].spelling != parameter) {
+                continue;
+            }
+            size_t next = i + 1;
+            while (next < tokens.size() &&
+                   tokens[next].kind == MacroToken::Kind::Punctuator &&
+                   tokens[next].spelling == ")") {
+                next++;
+            }
+            if (next + 1 < tokens.size() &&
+                tokens[next].kind == MacroToken::Kind::Punctuator &&
+                tokens[next].spelling == "->") {
+                fieldNames.push_back(tokens[next + 1].spelling);
+            } else {
+                isNumber = true;
+            }
+        }
+        if (!fieldNames.empty()) {
+            if (isNumber) {
+                skipReason = "parameter `" + parameter +
+                             "` is used both as a pointer and as a number";
+                return false;
+            }
+            /* find the only struct that has all accessed fields */
+            const std::pair<std::shared_ptr<const Struct>,
+                            std::shared_ptr<const TypeDef>> *found = nullptr;
+            for (const auto &s : structs) {
+                bool hasFields = true;
+                for (const auto &fieldName : fieldNames) {
+                    bool hasField = false;
+                    for (const auto &field : s.first->getFields()) {
+                        hasField = hasField || field->getName() == fieldName;
+                    }
+                    hasFields = hasFields && hasField;
+                }
+                if (!hasFields) {
+                    continue;
+                }
+                if (found) {
+                    skipReason = "several structs have fields accessed "
+                                 "through parameter `" +
+                                 parameter + "`";
+                    return false;
+                }
+                found = &s;
+            }
+            if (!found) {
+                skipReason = "there is no struct with fields accessed "
+                             "through parameter `" +
+                             parameter + "`";
+                return false;
+            }
+            info.isPointer = true;
+            info.scalaName = info.scalaName + ": native.Ptr[" +
+                             found->second->str(locationManager) + "]";
+            for (const auto &field : found->first->getFields()) {
+                std::string type = getPrimitiveTypeName(field->getType());
+                if (type == "native.CUnsignedInt" ||
+                    type == "native.CUnsignedLong" ||
+                    type == "native.CUnsignedLongLong" ||
+                    type == "native.CFloat" || type == "native.CDouble") {
+                    /* Scala Int and Long cannot represent
+                     * C unsigned arithmetic */
+                    type.clear();
+                }
+                info.fields.emplace(
+                    field->getName(),
+                    FieldAccess{handleReservedWords(field->getName()), type});
+            }
+            for (const auto &fieldName : fieldNames) {
+                if (info.fields.at(fieldName).type.empty()) {
+                    skipReason = "field `" + fieldName +
+                                 "` does not have a signed integer type";
+                    return false;
+                }
+            }
+            hasFieldAccess = true;
+        } else {
+            info.scalaName = info.scalaName + ": native.CLong";
+        }
+        parameterInfos.emplace(parameter, info);
+    }
+
+    /* declarations of parameters are replaced by their names */
+    std::unordered_map<std::string, MacroParameter> parameterNames;
+    std::vector<std::string> declarations;
+    for (const auto &parameter : parameters) {
+        MacroParameter info = parameterInfos.at(parameter);
+        declarations.push_back(info.scalaName);
+        info.scalaName = handleReservedWords(parameter);
+        parameterNames.emplace(parameter, info);
+    }
+
+    ExpressionTranslator translator(tokens, parameterNames);
+    Expression expression;
+    if (!translator.translate(expression)) {
+        skipReason = translator.getError();
+        return false;
+    }
+    std::string returnType;
+    switch (expression.type) {
+    case Expression::Type::Int:
+        returnType = "native.CInt";
+        break;
+    case Expression::Type::Long:
+        returnType = "native.CLong";
+        break;
+    case Expression::Type::Boolean:
+        returnType = "native.CBool";
+        break;
+    case Expression::Type::Pointer:
+        skipReason = "it is not an integer expression";
+        return false;
+    }
+
+    std::string parameterList;
+    for (const auto &declaration : declarations) {
+        if (!parameterList.empty()) {
+            parameterList += ", ";
+        }
+        parameterList += declaration;
+    }
+    definition = "    @inline def " + handleReservedWords(name) + "(" +
+                 parameterList + "): " + returnType + " = " +
+                 stripParentheses(expression.code) + "\n";
+    return true;
+}
+
+std::string FunctionDefine::getDefinition() const { return definition; }
+
+std::string FunctionDefine::getSkipReason() const { return skipReason; }
+
+bool FunctionDefine::usesImplicits() const {
+    return !definition.empty() && hasFieldAccess;
+}
@@ -0,0 +1,83 @@
+#ifndef SCALA_NATIVE_BINDGEN_FUNCTIONDEFINE_H
+#define SCALA_NATIVE_BINDGEN_FUNCTIONDEFINE_H
+
+#include "Define.h"
+#include "Struct.h"
+#include <vector>
+
+/**
+ * Token of the body of function-like macro.
+ * Object-like macros in the body are already expanded.
+ */
+struct MacroToken {
+    enum class Kind {
+        Parameter,
+        /* identifier that is not a parameter */
+        Identifier,
+        /* signed integer literal that fits into Int or Long */
+        Integer,
+        Punctuator,
+        Other
+    };
+
+    MacroToken(Kind kind, std::string spelling);
+
+    Kind kind;
+    /* Scala literal for Integer tokens */
+    std::string spelling;
+};
+
+/**
+ * Function-like macro that is translated to inline Scala function if its
+ * body is an integer expression, for example:
+ * @code
+ * #define HDR_LEN(h) (((h)->vl & 0x0f) << 2)
+ * @endcode
+ * Becomes:
+ * @code
+ * @inline def HDR_LEN(h: native.Ptr[struct_hdr]): native.CInt = (h.vl.toInt & 15) << 2
+ * @endcode
+ *
+ * Parameters followed by `->` are pointers to the only struct that has all
+ * accessed fields, other parameters are native.CLong.
+ */
+class FunctionDefine : public Define {
+  public:
+    FunctionDefine(std::string name, std::vector<std::string> parameters,
+                   std::vector<MacroToken> tokens, bool isVariadic);
+
+    /**
+     * Translates body of the macro.
+     *
+     * @param structs printed structs with helper methods and their typedefs
+     * @return false if the macro cannot be translated,
+     *         see getSkipReason
+     */
+    bool translate(const std::vector<std::pair<std::shared_ptr<const Struct>,
+                                               std::shared_ptr<const TypeDef>>>
+                       &structs,
+                   const LocationManager &locationManager);
+
+    /**
+     * @return definition of inline function. Empty if the macro
+     *         was not translated
+     */
+    std::string getDefinition() const;
+
+    std::string getSkipReason() const;
+
+    /**
+     * @return true if the function uses helper methods of structs
+     */
+    bool usesImplicits() const;
+
+  private:
+    std::vector<std::string> parameters;
+    std::vector<MacroToken> tokens;
+    bool isVariadic;
+    std::string definition;
+    std::string skipReason;
+    bool hasFieldAccess = false;
+};
+
+#endif // SCALA_NATIVE_BINDGEN_FUNCTIONDEFINE_H
@@ -1,33 +1,42 @@
 #include "IR.h"
 #include "../Utils.h"
+#include <algorithm>
+#include <sstream>
 
 IR::IR(std::string libName, std::string linkName, std::string objectName,
-       std::string packageName, const LocationManager &locationManager)
+       std::string packageName, LocationManager &locationManager,
+       llvm::raw_ostream &diagnostics)
     : libName(std::move(libName)), linkName(std::move(linkName)),
       objectName(std::move(objectName)), locationManager(locationManager),
+      diagnostics(diagnostics), typeFactory(arena),
       packageName(std::move(packageName)) {}
 
-void IR::addFunction(std::string name,
-                     std::vector<std::shared_ptr<Parameter>> parameters,
-                     std::shared_ptr<Type> retType, bool isVariadic) {
-    functions.push_back(std::make_shared<Function>(name, std::move(parameters),
-                                                   retType, isVariadic));
+std::shared_ptr<Function>
+IR::addFunction(std::string name,
+                std::vector<std::shared_ptr<Parameter>> parameters,
+                std::shared_ptr<Type> retType, bool isVariadic) {
+    functions.push_back(arena.make<Function>(name, std::move(parameters),
+                                             retType, isVariadic));
+    functionsByName.emplace(name, functions.back());
+    return functions.back();
 }
 
 std::shared_ptr<TypeDef> IR::addTypeDef(std::string name,
                                         std::shared_ptr<Type> type,
                                         std::shared_ptr<Location> location) {
     typeDefs.push_back(
-        std::make_shared<TypeDef>(std::move(name), type, std::move(location)));
+        arena.make<TypeDef>(std::move(name), type, std::move(location)));
+    typeDefsByName.emplace(typeDefs.back()->getName(), typeDefs.back());
     return typeDefs.back();
 }
 
 std::shared_ptr<Enum> IR::addEnum(std::string name, const std::string &type,
                                   std::vector<Enumerator> enumerators,
                                   std::shared_ptr<Location> location) {
-    std::shared_ptr<Enum> e = std::make_shared<Enum>(
+    std::shared_ptr<Enum> e = arena.make<Enum>(
         std::move(name), type, std::move(enumerators), std::move(location));
     enums.push_back(e);
+    enumsByName.emplace(e->getName(), e);
     return e;
 }
 
@@ -36,8 +45,9 @@ IR::addStruct(std::string name, std::vector<std::shared_ptr<Field>> fields,
               uint64_t typeSize, std::shared_ptr<Location> location,
               bool isPacked, bool isBitField) {
     std::shared_ptr<Struct> s =
-        std::make_shared<Struct>(name, std::move(fields), typeSize,
-                                 std::move(location), isPacked, isBitField);
+        arena.make<Struct>(name, std::move(fields), typeSize,
+                           std::move(location), isPacked, isBitField,
+                           typeFactory);
     structs.push_back(s);
     std::shared_ptr<TypeDef> typeDef = getTypeDefWithName("struct " + name);
     if (typeDef) {
@@ -46,6 +56,7 @@ IR::addStruct(std::string name, std::vector<std::shared_ptr<Field>> fields,
         return typeDef;
     } else {
         typeDefs.push_back(s->generateTypeDef());
+        typeDefsByName.emplace(typeDefs.back()->getName(), typeDefs.back());
         return typeDefs.back();
     }
 }
@@ -53,8 +64,9 @@ IR::addStruct(std::string name, std::vector<std::shared_ptr<Field>> fields,
 std::shared_ptr<TypeDef>
 IR::addUnion(std::string name, std::vector<std::shared_ptr<Field>> fields,
              uint64_t maxSize, std::shared_ptr<Location> location) {
-    std::shared_ptr<Union> u = std::make_shared<Union>(
-        name, std::move(fields), maxSize, std::move(location));
+    std::shared_ptr<Union> u =
+        arena.make<Union>(name, std::move(fields), maxSize,
+                          std::move(location), typeFactory);
     unions.push_back(u);
     std::shared_ptr<TypeDef> typeDef = getTypeDefWithName("union " + name);
     if (typeDef) {
@@ -63,32 +75,60 @@ IR::addUnion(std::string name, std::vector<std::shared_ptr<Field>> fields,
         return typeDef;
     } else {
         typeDefs.push_back(u->generateTypeDef());
+        typeDefsByName.emplace(typeDefs.back()->getName(), typeDefs.back());
         return typeDefs.back();
     }
 }
 
 void IR::addLiteralDefine(std::string name, std::string literal,
                           std::shared_ptr<Type> type) {
-    literalDefines.push_back(std::make_shared<LiteralDefine>(
+    defineNames.insert(name);
+    literalDefines.push_back(arena.make<LiteralDefine>(
         std::move(name), std::move(literal), type));
 }
 
 void IR::addPossibleVarDefine(const std::string &macroName,
                               const std::string &varName) {
     possibleVarDefines.push_back(
-        std::make_shared<PossibleVarDefine>(macroName, varName));
+        arena.make<PossibleVarDefine>(macroName, varName));
+    possibleVarDefinesByVar.emplace(varName, possibleVarDefines.back());
+    defineNames.insert(macroName);
+    /* macros and declarations are collected in a single pass,
+     * therefore the variable may already be declared */
+    std::shared_ptr<Variable> variable = getVariableWithName(varName);
+    if (variable) {
+        addVarDefine(macroName, variable);
+    }
 }
 
 void IR::addVarDefine(std::string name, std::shared_ptr<Variable> variable) {
-    varDefines.push_back(
-        std::make_shared<VarDefine>(std::move(name), variable));
+    defineNames.insert(name);
+    varDefines.push_back(arena.make<VarDefine>(std::move(name), variable));
+}
+
+void IR::addPossibleConstantDefine(const std::string &macroName) {
+    possibleConstantDefines.push_back(macroName);
+}
+
+const std::vector<std::string> &IR::getPossibleConstantDefines() const {
+    return possibleConstantDefines;
+}
+
+void IR::addFunctionDefine(std::string name,
+                           std::vector<std::string> parameters,
+                           std::vector<MacroToken> tokens, bool isVariadic) {
+    defineNames.insert(name);
+    functionDefines.push_back(arena.make<FunctionDefine>(
+        std::move(name), std::move(parameters), std::move(tokens),
+        isVariadic));
 }
 
 bool IR::libObjEmpty() const {
     return functions.empty() && !shouldOutputType(typeDefs) &&
            !shouldOutputType(structs) && !shouldOutputType(unions) &&
            varDefines.empty() && variables.empty() &&
-           !shouldOutputType(enums) && literalDefines.empty();
+           !shouldOutputType(enums) && literalDefines.empty() &&
+           !hasTranslatedFunctionDefines();
 }
 
 llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const IR &ir) {
@@ -98,6 +138,16 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const IR &ir) {
         s << "package " << ir.packageName << "\n\n";
     }
 
+    for (const auto &functionDefine : ir.functionDefines) {
+        if (functionDefine->getDefinition().empty()) {
+            ir.diagnostics << "Warning: Function-like macro "
+                           << functionDefine->getName()
+                           << " is skipped because "
+                           << functionDefine->getSkipReason() << ".\n";
+            ir.diagnostics.flush();
+        }
+    }
+
     if (ir.libObjEmpty()) {
         return s;
     }
@@ -114,28 +164,24 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const IR &ir) {
     }
     s << "object " << handleReservedWords(ir.objectName) << " {\n";
 
-    std::vector<std::shared_ptr<const Type>> visitedTypes;
-
     for (const auto &e : ir.enums) {
-        visitedTypes.clear();
-        if (ir.shouldOutput(e, visitedTypes)) {
+        if (ir.shouldOutput(e)) {
             s << e->getDefinition();
             s << e->getEnumerators() << "\n";
         }
     }
 
     for (const auto &typeDef : ir.typeDefs) {
-        visitedTypes.clear();
-        if (ir.shouldOutputTypeDef(typeDef, visitedTypes)) {
+        if (ir.shouldOutput(typeDef)) {
             s << typeDef->getDefinition(ir.locationManager);
         } else if (typeDef->hasLocation() &&
                    isAliasForOpaqueType(typeDef.get()) &&
                    ir.locationManager.inMainFile(*typeDef->getLocation())) {
-            llvm::errs() << "Warning: type alias " + typeDef->getName()
-                         << " is skipped because it is an unused alias for "
-                            "incomplete type."
-                         << "\n";
-            llvm::errs().flush();
+            ir.diagnostics << "Warning: type alias " + typeDef->getName()
+                           << " is skipped because it is an unused alias for "
+                              "incomplete type."
+                           << "\n";
+            ir.diagnostics.flush();
         }
     }
 
@@ -143,8 +189,8 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const IR &ir) {
         if (!variable->hasIllegalUsageOfOpaqueType()) {
             s << variable->getDefinition(ir.locationManager);
         } else {
-            llvm::errs() << "Error: Variable " << variable->getName()
-                         << " is skipped because it has incomplete type.\n";
+            ir.diagnostics << "Error: Variable " << variable->getName()
+                           << " is skipped because it has incomplete type.\n";
         }
     }
 
@@ -152,28 +198,38 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const IR &ir) {
         if (!varDefine->hasIllegalUsageOfOpaqueType()) {
             s << varDefine->getDefinition(ir.locationManager);
         } else {
-            llvm::errs() << "Error: Variable alias " << varDefine->getName()
-                         << " is skipped because it has incomplete type.\n";
-            llvm::errs().flush();
+            ir.diagnostics << "Error: Variable alias " << varDefine->getName()
+                           << " is skipped because it has incomplete type.\n";
+            ir.diagnostics.flush();
         }
     }
 
     for (const auto &func : ir.functions) {
         if (!func->isLegalScalaNativeFunction()) {
-            llvm::errs() << "Warning: Function " << func->getName()
-                         << " is skipped because Scala Native does not support "
-                            "passing structs and arrays by value.\n";
-            llvm::errs().flush();
+            ir.diagnostics
+                << "Warning: Function " << func->getName()
+                << " is skipped because Scala Native does not support "
+                   "passing structs and arrays by value.\n";
+            ir.diagnostics.flush();
         } else {
             s << func->getDefinition(ir.locationManager);
         }
     }
 
-    if (!ir.literalDefines.empty()) {
+    if (!ir.literalDefines.empty() || ir.hasTranslatedFunctionDefines()) {
         s << "\n  object defines {\n";
+        for (const auto &functionDefine : ir.functionDefines) {
+            if (functionDefine->usesImplicits()) {
+                s << "    import implicits._\n";
+                break;
+            }
+        }
         for (const auto &literalDefine : ir.literalDefines) {
             s << literalDefine->getDefinition(ir.locationManager);
         }
+        for (const auto &functionDefine : ir.functionDefines) {
+            s << functionDefine->getDefinition();
+        }
         s << "  }\n";
     }
 
@@ -182,8 +238,19 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const IR &ir) {
     }
 
     for (const auto &str : ir.structs) {
-        visitedTypes.clear();
-        if (ir.shouldOutput(str, visitedTypes) && str->hasHelperMethods()) {
+        if (!ir.shouldOutput(str)) {
+            continue;
+        }
+        std::string bitField = str->getBitFieldThatDoesNotFit();
+        if (!bitField.empty()) {
+            ir.diagnostics << "Warning: helper methods of "
+                           << str->getTypeName()
+                           << " are not generated because bit field "
+                           << bitField
+                           << " does not fit into an integer inside the struct."
+                           << "\n";
+            ir.diagnostics.flush();
+        } else if (str->hasHelperMethods()) {
             s << "\n" << str->getConstructorHelper(ir.locationManager);
         }
     }
@@ -193,26 +260,45 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const IR &ir) {
     return s;
 }
 
+std::string IR::getShims(const std::string &header) const {
+    assert(generated);
+
+    std::stringstream s;
+    s << "/* Generated by scala-native-bindgen. Wrappers of functions that "
+         "do not\n * have linkable symbol or pass structs and unions by "
+         "value. */\n"
+      << "#include \"" << header << "\"\n";
+    /* a function may be declared several times */
+    std::unordered_set<std::string> shimNames;
+    for (const auto &func : functions) {
+        if (!func->getShim().empty() && func->isLegalScalaNativeFunction() &&
+            shimNames.insert(func->getShimName()).second) {
+            s << "\n" << func->getShim();
+        }
+    }
+    return s.str();
+}
+
 void IR::generate(const std::string &excludePrefix) {
     if (!generated) {
         setScalaNames();
         filterDeclarations(excludePrefix);
+        findFieldsThatBreakCycles();
+        findOutputTypes();
+        translateFunctionDefines();
         generated = true;
     }
 }
 
 bool IR::hasHelperMethods() const {
-    std::vector<std::shared_ptr<const Type>> visitedTypes;
     for (const auto &u : unions) {
-        visitedTypes.clear();
-        if (shouldOutput(u, visitedTypes) && u->hasHelperMethods()) {
+        if (shouldOutput(u) && u->hasHelperMethods()) {
             return true;
         }
     }
 
     for (const auto &s : structs) {
-        visitedTypes.clear();
-        if (shouldOutput(s, visitedTypes) && s->hasHelperMethods()) {
+        if (shouldOutput(s) && s->hasHelperMethods()) {
             return true;
         }
     }
@@ -227,12 +313,16 @@ void IR::filterDeclarations(const std::string &excludePrefix) {
     filterTypeDefs(excludePrefix);
 
     filterByPrefix(functions, excludePrefix);
+    indexByName(functionsByName, functions);
 
     filterByPrefix(literalDefines, excludePrefix);
 
+    filterByPrefix(functionDefines, excludePrefix);
+
     filterByPrefix(varDefines, excludePrefix);
 
     filterByPrefix(variables, excludePrefix);
+    indexByName(variablesByName, variables);
 }
 
 void IR::filterTypeDefs(const std::string &excludePrefix) {
@@ -247,10 +337,11 @@ void IR::filterTypeDefs(const std::string &excludePrefix) {
             ++it;
         }
     }
+    indexByName(typeDefsByName, typeDefs);
 }
 
-void IR::replaceTypeInTypeDefs(std::shared_ptr<const Type> oldType,
-                               std::shared_ptr<const Type> newType) {
+void IR::replaceTypeInTypeDefs(const std::shared_ptr<const Type> &oldType,
+                               const std::shared_ptr<const Type> &newType) {
     for (auto &typeDef : typeDefs) {
         if (typeDef->getType() == oldType) {
             typeDef->setType(newType);
@@ -260,9 +351,9 @@ void IR::replaceTypeInTypeDefs(std::shared_ptr<const Type> oldType,
 
 template <typename T>
 bool IR::isTypeUsed(const std::vector<T> &declarations,
-                    std::shared_ptr<const Type> type,
+                    const std::shared_ptr<const Type> &type,
                     bool stopOnTypeDefs) const {
-    std::vector<std::shared_ptr<const Type>> visitedTypes;
+    std::vector<const Type *> visitedTypes;
     for (const auto &decl : declarations) {
         visitedTypes.clear();
         if (decl->usesType(type, stopOnTypeDefs, visitedTypes)) {
@@ -282,49 +373,327 @@ bool IR::typeIsUsedOnlyInTypeDefs(
         isTypeUsed(literalDefines, type, true));
 }
 
-bool IR::isTypeUsed(
-    const std::shared_ptr<const Type> &type,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
-    if (contains(type.get(), visitedTypes)) {
-        return false;
+void IR::findFieldsThatBreakCycles() {
+    std::unordered_map<const Struct *, size_t> structIndexes;
+    for (size_t i = 0; i < structs.size(); i++) {
+        structIndexes.emplace(structs[i].get(), i);
+    }
+
+    /* referencedStructs[i][j] contains structs that are referenced by j-th
+     * field of i-th struct. successors and predecessors are edges of the
+     * graph, predecessor edge also tells whether the field has value type */
+    std::vector<std::vector<std::vector<size_t>>> referencedStructs(
+        structs.size());
+    std::vector<std::vector<size_t>> successors(structs.size());
+    std::vector<std::vector<std::pair<size_t, bool>>> predecessors(
+        structs.size());
+    std::vector<std::shared_ptr<const Struct>> foundStructs;
+    std::vector<const Type *> visitedTypes;
+    for (size_t i = 0; i < structs.size(); i++) {
+        for (const auto &field : structs[i]->getFields()) {
+            const Type *type = field->getType().get();
+            bool isValueType = isAliasForType<Struct>(type) ||
+                               isAliasForType<Union>(type);
+            foundStructs.clear();
+            visitedTypes.clear();
+            field->getType()->collectReferencedStructs(foundStructs,
+                                                       visitedTypes);
+            std::vector<size_t> references;
+            for (const auto &s : foundStructs) {
+                auto it = structIndexes.find(s.get());
+                if (it != structIndexes.end() &&
+                    std::find(references.begin(), references.end(),
+                              it->second) == references.end()) {
+                    references.push_back(it->second);
+                    successors[i].push_back(it->second);
+                    predecessors[it->second].emplace_back(i, isValueType);
+                }
+            }
+            referencedStructs[i].push_back(std::move(references));
+        }
     }
-    visitedTypes.push_back(type);
-    if (isTypeUsed(functions, type, true) ||
-        isTypeUsed(variables, type, true) ||
-        isTypeUsed(literalDefines, type, true)) {
-        return true;
+
+    /* Tarjan's algorithm, implemented without recursion */
+    const size_t notVisited = structs.size();
+    std::vector<size_t> order(structs.size(), notVisited);
+    std::vector<size_t> lowLink(structs.size());
+    std::vector<size_t> components(structs.size());
+    std::vector<bool> isOnStack(structs.size(), false);
+    std::vector<size_t> stack;
+    /* struct and index of next successor */
+    std::vector<std::pair<size_t, size_t>> callStack;
+    size_t nextOrder = 0;
+    size_t componentsCount = 0;
+    for (size_t root = 0; root < structs.size(); root++) {
+        if (order[root] != notVisited) {
+            continue;
+        }
+        callStack.emplace_back(root, 0);
+        while (!callStack.empty()) {
+            size_t v = callStack.back().first;
+            size_t successorIndex = callStack.back().second;
+            if (successorIndex == 0 && order[v] == notVisited) {
+                order[v] = lowLink[v] = nextOrder++;
+                stack.push_back(v);
+                isOnStack[v] = true;
+            }
+            if (successorIndex < successors[v].size()) {
+                callStack.back().second++;
+                size_t w = successors[v][successorIndex];
+                if (order[w] == notVisited) {
+                    callStack.emplace_back(w, 0);
+                } else if (isOnStack[w]) {
+                    lowLink[v] = std::min(lowLink[v], order[w]);
+                }
+                continue;
+            }
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                size_t parent = callStack.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[v]);
+            }
+            if (lowLink[v] == order[v]) {
+                size_t w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    isOnStack[w] = false;
+                    components[w] = componentsCount;
+                } while (w != v);
+                componentsCount++;
+            }
+        }
     }
-    /* type is used if there exists another type that is used and that
-     * references this type */
-    std::vector<std::shared_ptr<const Type>> visitedTypesInner;
-    for (const auto &typeDef : typeDefs) {
-        visitedTypesInner.clear();
-        if (typeDef->usesType(type, false, visitedTypesInner)) {
-            if (shouldOutputTypeDef(typeDef, visitedTypes)) {
-                return true;
+
+    /* reachedFrom[j] == i + 1 if i-th struct is reachable from j-th struct
+     * through structs that have smaller names or fields of value type */
+    std::vector<size_t> reachedFrom(structs.size(), 0);
+    std::vector<size_t> queue;
+    for (size_t i = 0; i < structs.size(); i++) {
+        const std::vector<std::shared_ptr<Field>> &fields =
+            structs[i]->getFields();
+        bool isReachabilityComputed = false;
+        for (size_t j = 0; j < fields.size(); j++) {
+            const Type *type = fields[j]->getType().get();
+            if (isAliasForType<Struct>(type) || isAliasForType<Union>(type)) {
+                /* cycle should be broken on pointer type */
+                continue;
             }
+            std::vector<size_t> structsInCycle;
+            bool referencesItself = false;
+            for (size_t s : referencedStructs[i][j]) {
+                if (s == i) {
+                    referencesItself = true;
+                } else if (components[s] == components[i]) {
+                    structsInCycle.push_back(s);
+                }
+            }
+            std::vector<std::shared_ptr<const Struct>> structsThatBreakCycle;
+            if (referencesItself) {
+                /* field references containing struct */
+                structsThatBreakCycle.push_back(structs[i]);
+            }
+            if (structsInCycle.empty()) {
+                fields[j]->setStructsThatBreakCycle(
+                    std::move(structsThatBreakCycle));
+                continue;
+            }
+            if (!isReachabilityComputed) {
+                std::string name = structs[i]->getTypeName();
+                queue.assign(1, i);
+                while (!queue.empty()) {
+                    size_t s = queue.back();
+                    queue.pop_back();
+                    for (const auto &predecessor : predecessors[s]) {
+                        size_t p = predecessor.first;
+                        if (p == i || components[p] != components[i] ||
+                            reachedFrom[p] == i + 1) {
+                            continue;
+                        }
+                        if (!predecessor.second &&
+                            structs[p]->getTypeName() > name) {
+                            continue;
+                        }
+                        reachedFrom[p] = i + 1;
+                        queue.push_back(p);
+                    }
+                }
+                isReachabilityComputed = true;
+            }
+            for (size_t s : structsInCycle) {
+                if (reachedFrom[s] == i + 1) {
+                    structsThatBreakCycle.push_back(structs[s]);
+                }
+            }
+            fields[j]->setStructsThatBreakCycle(
+                std::move(structsThatBreakCycle));
         }
     }
+}
+
+void IR::findOutputTypes() {
+    /* typedefs, structs, unions and enums are nodes of the graph,
+     * typedefs go first */
+    std::vector<std::shared_ptr<const LocatableType>> types;
+    std::unordered_map<const Type *, size_t> typeIndexes;
+    auto addType = [&](std::shared_ptr<const LocatableType> type) {
+        typeIndexes.emplace(type.get(), types.size());
+        types.push_back(std::move(type));
+    };
+    for (const auto &typeDef : typeDefs) {
+        addType(typeDef);
+    }
     for (const auto &s : structs) {
-        /* stopOnTypeDefs parameter is true because because typedefs were
-         * checked */
-        visitedTypesInner.clear();
-        if (s->usesType(type, true, visitedTypesInner)) {
-            if (shouldOutput(s, visitedTypes)) {
-                return true;
+        addType(s);
+    }
+    for (const auto &u : unions) {
+        addType(u);
+    }
+    for (const auto &e : enums) {
+        addType(e);
+    }
+
+    /* foundTypes may contain types that are not nodes of the graph,
+     * for example pointer types. They are skipped here */
+    std::vector<std::shared_ptr<const Type>> foundTypes;
+    auto getIndexes = [&](std::vector<size_t> &indexes) {
+        for (const auto &type : foundTypes) {
+            auto it = typeIndexes.find(type.get());
+            if (it != typeIndexes.end()) {
+                indexes.push_back(it->second);
+            }
+        }
+        foundTypes.clear();
+    };
+
+    /* edges from a type to types that it directly uses */
+    std::vector<std::vector<size_t>> usedTypes(types.size());
+    std::vector<const Type *> visitedTypes;
+    for (size_t i = 0; i < types.size(); i++) {
+        visitedTypes.clear();
+        if (i < typeDefs.size()) {
+            const std::shared_ptr<const Type> &type = typeDefs[i]->getType();
+            if (type) {
+                foundTypes.push_back(type);
+                type->collectUsedTypes(foundTypes, visitedTypes);
             }
+        } else {
+            types[i]->collectUsedTypes(foundTypes, visitedTypes);
         }
+        getIndexes(usedTypes[i]);
     }
-    for (const auto &u : unions) {
-        /* stopOnTypeDefs parameter is true because because typedefs were
-         * checked */
-        visitedTypesInner.clear();
-        if (u->usesType(type, true, visitedTypesInner)) {
-            if (shouldOutput(u, visitedTypes)) {
-                return true;
+
+    auto shouldOutputAt = [&](size_t i, bool isUsed) -> bool {
+        if (i < typeDefs.size()) {
+            return shouldOutputTypeDef(typeDefs[i], isUsed);
+        }
+        return shouldOutput(types[i], isUsed);
+    };
+
+    std::vector<bool> isUsed(types.size(), false);
+    std::vector<bool> isOutput(types.size(), false);
+    /* true if all types reachable from the type are marked as used */
+    std::vector<bool> isExpanded(types.size(), false);
+    std::vector<size_t> newUsedTypes;
+    std::vector<size_t> newOutputTypes;
+    auto markUsed = [&](size_t i) {
+        if (!isUsed[i]) {
+            isUsed[i] = true;
+            newUsedTypes.push_back(i);
+        }
+    };
+
+    for (size_t i = 0; i < types.size(); i++) {
+        if (shouldOutputAt(i, false)) {
+            isOutput[i] = true;
+            newOutputTypes.push_back(i);
+        }
+    }
+
+    /* varDefines are not checked here because they are simply
+     * aliases for variables.*/
+    std::vector<size_t> rootTypes;
+    for (const auto &function : functions) {
+        function->collectUsedTypes(foundTypes);
+    }
+    for (const auto &variable : variables) {
+        variable->collectUsedTypes(foundTypes);
+    }
+    for (const auto &literalDefine : literalDefines) {
+        literalDefine->collectUsedTypes(foundTypes);
+    }
+    getIndexes(rootTypes);
+    for (size_t i : rootTypes) {
+        markUsed(i);
+    }
+
+    std::vector<size_t> stack;
+    while (!newUsedTypes.empty() || !newOutputTypes.empty()) {
+        while (!newUsedTypes.empty()) {
+            size_t i = newUsedTypes.back();
+            newUsedTypes.pop_back();
+            if (!isOutput[i] && shouldOutputAt(i, true)) {
+                isOutput[i] = true;
+                newOutputTypes.push_back(i);
+            }
+        }
+        while (!newOutputTypes.empty()) {
+            size_t i = newOutputTypes.back();
+            newOutputTypes.pop_back();
+            if (i >= typeDefs.size()) {
+                /* structs and unions use only types of their fields */
+                for (size_t j : usedTypes[i]) {
+                    markUsed(j);
+                }
+                continue;
+            }
+            /* typedef uses all types that are reachable from it */
+            stack = usedTypes[i];
+            while (!stack.empty()) {
+                size_t j = stack.back();
+                stack.pop_back();
+                markUsed(j);
+                if (!isExpanded[j]) {
+                    isExpanded[j] = true;
+                    stack.insert(stack.end(), usedTypes[j].begin(),
+                                 usedTypes[j].end());
+                }
+            }
+        }
+    }
+
+    outputTypes.clear();
+    for (size_t i = 0; i < types.size(); i++) {
+        if (shouldOutputAt(i, isUsed[i])) {
+            outputTypes.insert(types[i].get());
+        }
+    }
+}
+
+void IR::translateFunctionDefines() {
+    std::vector<std::pair<std::shared_ptr<const Struct>,
+                          std::shared_ptr<const TypeDef>>>
+        structsWithHelpers;
+    for (const auto &s : structs) {
+        if (shouldOutput(s) && s->hasHelperMethods()) {
+            std::shared_ptr<TypeDef> typeDef =
+                getTypeDefWithName(s->getTypeName());
+            if (typeDef) {
+                structsWithHelpers.emplace_back(s, typeDef);
             }
         }
     }
+    for (const auto &functionDefine : functionDefines) {
+        functionDefine->translate(structsWithHelpers, locationManager);
+    }
+}
+
+bool IR::hasTranslatedFunctionDefines() const {
+    for (const auto &functionDefine : functionDefines) {
+        if (!functionDefine->getDefinition().empty()) {
+            return true;
+        }
+    }
     return false;
 }
 
@@ -344,19 +713,41 @@ void IR::setScalaNames() {
     }
 }
 
-bool IR::existsFunctionWithName(std::string functionName) {
-    for (const auto &function : functions) {
-        if (function->getName() == functionName) {
-            return true;
-        }
-    }
-    return false;
+bool IR::existsFunctionWithName(const std::string &functionName) const {
+    return functionsByName.find(functionName) != functionsByName.end();
 }
 
 void IR::removeDefine(const std::string &name) {
+    possibleConstantDefines.erase(std::remove(possibleConstantDefines.begin(),
+                                              possibleConstantDefines.end(),
+                                              name),
+                                  possibleConstantDefines.end());
+    if (defineNames.erase(name) == 0) {
+        /* most of undefined macros were not translated */
+        return;
+    }
     filterByName(literalDefines, name);
     filterByName(possibleVarDefines, name);
     filterByName(varDefines, name);
+    filterByName(functionDefines, name);
+    indexPossibleVarDefines();
+}
+
+template <typename T>
+void IR::indexByName(std::unordered_map<std::string, T> &index,
+                     const std::vector<T> &declarations) {
+    index.clear();
+    for (const auto &declaration : declarations) {
+        index.emplace(declaration->getName(), declaration);
+    }
+}
+
+void IR::indexPossibleVarDefines() {
+    possibleVarDefinesByVar.clear();
+    for (const auto &varDefine : possibleVarDefines) {
+        possibleVarDefinesByVar.emplace(varDefine->getVariableName(),
+                                        varDefine);
+    }
 }
 
 template <typename T>
@@ -385,18 +776,18 @@ void IR::filterByName(std::vector<T> &declarations, const std::string &name) {
 }
 
 std::string IR::getDefineForVar(const std::string &varName) const {
-    for (const auto &varDefine : possibleVarDefines) {
-        if (varDefine->getVariableName() == varName) {
-            return varDefine->getName();
-        }
+    auto it = possibleVarDefinesByVar.find(varName);
+    if (it == possibleVarDefinesByVar.end()) {
+        return "";
     }
-    return "";
+    return it->second->getName();
 }
 
 std::shared_ptr<Variable> IR::addVariable(const std::string &name,
                                           std::shared_ptr<Type> type) {
-    std::shared_ptr<Variable> variable = std::make_shared<Variable>(name, type);
+    std::shared_ptr<Variable> variable = arena.make<Variable>(name, type);
     variables.push_back(variable);
+    variablesByName.emplace(name, variable);
     return variable;
 }
 
@@ -406,24 +797,34 @@ std::shared_ptr<TypeDef> IR::getTypeDefWithName(const std::string &name) const {
      *    was not created.
      * 2. TreeVisitor visits struct/union declaration and it checks whether a
      *    TypeDef already exists for it.*/
-    return getDeclarationWithName(typeDefs, name);
+    return getDeclarationWithName(typeDefsByName, name);
 }
 
 std::shared_ptr<Enum> IR::getEnumWithName(const std::string &name) const {
-    return getDeclarationWithName(enums, name);
+    return getDeclarationWithName(enumsByName, name);
+}
+
+std::shared_ptr<Variable>
+IR::getVariableWithName(const std::string &name) const {
+    return getDeclarationWithName(variablesByName, name);
 }
 
+TypeFactory &IR::getTypeFactory() { return typeFactory; }
+
+Arena &IR::getArena() { return arena; }
+
+LocationManager &IR::getLocationManager() { return locationManager; }
+
+llvm::raw_ostream &IR::getDiagnostics() const { return diagnostics; }
+
 template <typename T>
-T IR::getDeclarationWithName(const std::vector<T> &declarations,
+T IR::getDeclarationWithName(const std::unordered_map<std::string, T> &index,
                              const std::string &name) const {
-    for (auto it = declarations.begin(), end = declarations.end(); it != end;
-         ++it) {
-        T declaration = (*it);
-        if (declaration->getName() == name) {
-            return declaration;
-        }
+    auto it = index.find(name);
+    if (it == index.end()) {
+        return nullptr;
     }
-    return nullptr;
+    return it->second;
 }
 
 IR::~IR() {
@@ -436,46 +837,44 @@ IR::~IR() {
     possibleVarDefines.clear();
     variables.clear();
     varDefines.clear();
+    functionDefines.clear();
+    functionsByName.clear();
+    typeDefsByName.clear();
+    enumsByName.clear();
+    variablesByName.clear();
+    possibleVarDefinesByVar.clear();
 }
 
 template <typename T>
 bool IR::shouldOutputType(
     const std::vector<std::shared_ptr<T>> &declarations) const {
-    std::vector<std::shared_ptr<const Type>> visitedTypes;
     for (const auto &declaration : declarations) {
-        visitedTypes.clear();
-        auto typeDefPointer =
-            std::dynamic_pointer_cast<const TypeDef>(declaration);
-        if (typeDefPointer) {
-            if (shouldOutputTypeDef(typeDefPointer, visitedTypes)) {
-                return true;
-            }
-        } else {
-            if (shouldOutput(declaration, visitedTypes)) {
-                return true;
-            }
+        if (shouldOutput(declaration)) {
+            return true;
         }
     }
     return false;
 }
 
-bool IR::shouldOutput(
-    const std::shared_ptr<const LocatableType> &type,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool IR::shouldOutput(const std::shared_ptr<const LocatableType> &type) const {
+    return outputTypes.find(type.get()) != outputTypes.end();
+}
+
+bool IR::shouldOutput(const std::shared_ptr<const LocatableType> &type,
+                      bool isUsed) const {
     if (locationManager.isImported(*type->getLocation())) {
         return false;
     }
-    if (isTypeUsed(type, visitedTypes)) {
+    if (isUsed) {
         return true;
     }
     /* remove unused types from included files */
     return locationManager.inMainFile(*type->getLocation());
 }
 
-bool IR::shouldOutputTypeDef(
-    const std::shared_ptr<const TypeDef> &typeDef,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
-    if (isTypeUsed(typeDef, visitedTypes)) {
+bool IR::shouldOutputTypeDef(const std::shared_ptr<const TypeDef> &typeDef,
+                             bool isUsed) const {
+    if (isUsed) {
         if (typeDef->wrapperForOpaqueType()) {
             /* it is not possible to get location of this typedef
              * so the typedef cannot be imported from other bindings */
@@ -493,21 +892,18 @@ bool IR::shouldOutputTypeDef(
 
 std::string IR::getHelperMethods() const {
     std::stringstream s;
-    std::vector<std::shared_ptr<const Type>> visitedTypes;
 
     std::string sep = "";
 
     for (const auto &st : structs) {
-        visitedTypes.clear();
-        if (shouldOutput(st, visitedTypes) && st->hasHelperMethods()) {
+        if (shouldOutput(st) && st->hasHelperMethods()) {
             s << sep << st->generateHelperClass(locationManager);
             sep = "\n";
         }
     }
 
     for (const auto &u : unions) {
-        visitedTypes.clear();
-        if (shouldOutput(u, visitedTypes) && u->hasHelperMethods()) {
+        if (shouldOutput(u) && u->hasHelperMethods()) {
             s << sep << u->generateHelperClass(locationManager);
         }
         sep = "\n";
@@ -1,8 +1,10 @@
 #ifndef SCALA_NATIVE_BINDGEN_INTERMEDIATEREPRESENTATION_H
 #define SCALA_NATIVE_BINDGEN_INTERMEDIATEREPRESENTATION_H
 
+#include "Arena.h"
 #include "Enum.h"
 #include "Function.h"
+#include "FunctionDefine.h"
 #include "LiteralDefine.h"
 #include "LocationManager.h"
 #include "PossibleVarDefine.h"
@@ -10,20 +12,30 @@
 #include "TypeDef.h"
 #include "Union.h"
 #include "VarDefine.h"
+#include "types/TypeFactory.h"
+#include <llvm/Support/raw_ostream.h>
+#include <unordered_map>
+#include <unordered_set>
 
 /**
  * Intermediate representation
  */
 class IR {
   public:
+    /**
+     * @param diagnostics stream for warnings about declarations that
+     *                    are skipped
+     */
     IR(std::string libName, std::string linkName, std::string objectName,
-       std::string packageName, const LocationManager &locationManager);
+       std::string packageName, LocationManager &locationManager,
+       llvm::raw_ostream &diagnostics = llvm::errs());
 
     ~IR();
 
-    void addFunction(std::string name,
-                     std::vector<std::shared_ptr<Parameter>> parameters,
-                     std::shared_ptr<Type> retType, bool isVariadic);
+    std::shared_ptr<Function>
+    addFunction(std::string name,
+                std::vector<std::shared_ptr<Parameter>> parameters,
+                std::shared_ptr<Type> retType, bool isVariadic);
 
     std::shared_ptr<TypeDef> addTypeDef(std::string name,
                                         std::shared_ptr<Type> type,
@@ -50,6 +62,19 @@ class IR {
 
     void addVarDefine(std::string name, std::shared_ptr<Variable> variable);
 
+    /**
+     * Add macro that may expand to a constant expression.
+     * The value is computed after the header is parsed,
+     * see DefineEvaluator.
+     */
+    void addPossibleConstantDefine(const std::string &macroName);
+
+    const std::vector<std::string> &getPossibleConstantDefines() const;
+
+    void addFunctionDefine(std::string name,
+                           std::vector<std::string> parameters,
+                           std::vector<MacroToken> tokens, bool isVariadic);
+
     std::shared_ptr<Variable> addVariable(const std::string &name,
                                           std::shared_ptr<Type> type);
 
@@ -61,6 +86,14 @@ class IR {
 
     friend llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const IR &ir);
 
+    /**
+     * @param header path of the header that is included by the source
+     * @return C source with wrappers of printed functions that do not
+     *         have linkable symbol or pass structs by value,
+     *         see Function::setShim
+     */
+    std::string getShims(const std::string &header) const;
+
     void generate(const std::string &excludePrefix);
 
     void removeDefine(const std::string &name);
@@ -75,7 +108,33 @@ class IR {
 
     std::shared_ptr<Enum> getEnumWithName(const std::string &name) const;
 
+    std::shared_ptr<Variable>
+    getVariableWithName(const std::string &name) const;
+
+    /**
+     * @return factory that should be used to create primitive types,
+     *         pointers, arrays and function pointers
+     */
+    TypeFactory &getTypeFactory();
+
+    /**
+     * @return arena in which declarations, fields, parameters, locations
+     *         and types are allocated. Nodes allocated in the arena must
+     *         not outlive the IR.
+     */
+    Arena &getArena();
+
+    /**
+     * @return location manager that indexes files of declarations
+     */
+    LocationManager &getLocationManager();
+
+    llvm::raw_ostream &getDiagnostics() const;
+
   private:
+    /* declared first because it must outlive all nodes */
+    Arena arena;
+
     /**
      * @return true if helper methods will be generated for this library
      */
@@ -110,8 +169,8 @@ class IR {
     /**
      * Find all typedefs that use oldType and replace it with newType.
      */
-    void replaceTypeInTypeDefs(std::shared_ptr<const Type> oldType,
-                               std::shared_ptr<const Type> newType);
+    void replaceTypeInTypeDefs(const std::shared_ptr<const Type> &oldType,
+                               const std::shared_ptr<const Type> &newType);
 
     /**
      * @return true if given type is used only in typedefs.
@@ -119,24 +178,17 @@ class IR {
     bool
     typeIsUsedOnlyInTypeDefs(const std::shared_ptr<const Type> &type) const;
 
-    /**
-     * @return true if type is used in one of declarations.
-     */
-    bool
-    isTypeUsed(const std::shared_ptr<const Type> &type,
-               std::vector<std::shared_ptr<const Type>> &visitedTypes) const;
-
     /**
      * @return true if type is used in one of given declarations.
      */
     template <typename T>
     bool isTypeUsed(const std::vector<T> &declarations,
-                    std::shared_ptr<const Type> type,
+                    const std::shared_ptr<const Type> &type,
                     bool stopOnTypeDefs) const;
 
     void setScalaNames();
 
-    bool existsFunctionWithName(std::string functionName);
+    bool existsFunctionWithName(const std::string &functionName) const;
 
     template <typename T>
     void filterByPrefix(std::vector<T> &declarations,
@@ -146,20 +198,83 @@ class IR {
     void filterByName(std::vector<T> &declarations, const std::string &name);
 
     template <typename T>
-    T getDeclarationWithName(const std::vector<T> &declarations,
+    T getDeclarationWithName(const std::unordered_map<std::string, T> &index,
                              const std::string &name) const;
 
+    /**
+     * Rebuild index after declarations were removed.
+     * First declaration with given name is stored in the index.
+     */
+    template <typename T>
+    void indexByName(std::unordered_map<std::string, T> &index,
+                     const std::vector<T> &declarations);
+
+    void indexPossibleVarDefines();
+
+    /**
+     * Scala Native does not support cyclic types.
+     * Cycles may contain structs, typedefs, pointer types and function
+     * pointer types.
+     * Unions are represented as arrays therefore they cannot belong to cycle.
+     * Cycle cannot be broken on value type. There exist at least one field in
+     * cycle of pointer type / function pointer type (or typedef alias to one of
+     * these types) because otherwise cycle produces structs of
+     * infinite size.
+     *
+     * Type of the field may contain a pointer to a struct (or typedef
+     * alias to this type).
+     * The pointer should be replaced with a pointer to Byte in following case:
+     * - field belongs to a cycle
+     * - name of the struct is the biggest among all structs in the
+     *   cycle that also have fields of non-value type.
+     *
+     * Note: a field may belong to one or more cycles. It is not enough to check
+     *       only one of cycles.
+     *
+     * Strongly connected components of the graph of structs are found once,
+     * structs that should be replaced are saved in fields
+     * (see Field::getStructsThatBreakCycle).
+     */
+    void findFieldsThatBreakCycles();
+
+    /**
+     * Find types that will be printed.
+     *
+     * A graph of usages between typedefs, structs, unions and enums is built
+     * once and usages are propagated from functions, variables, literal
+     * defines and printed types.
+     * A type is used if:
+     * - it is used by a function, a variable or a literal define
+     * - it is used by a struct or an union that is printed
+     * - a printed typedef references it (also through other types)
+     */
+    void findOutputTypes();
+
+    /**
+     * Translate function-like macros to inline functions.
+     * Field accesses are translated to helper methods of printed structs,
+     * therefore it is done after output types are found.
+     */
+    void translateFunctionDefines();
+
     /**
+     * @return true if the type will be printed.
+     *         Result is computed by findOutputTypes.
+     */
+    bool shouldOutput(const std::shared_ptr<const LocatableType> &type) const;
+
+    /**
+     * @param isUsed true if type is used in one of printed declarations.
      * @return true if the type will be printed.
      *         Following types are not printed:
      *         - Types that should be imported from other bindings
      *         - Unused types from included headers
      */
-    bool
-    shouldOutput(const std::shared_ptr<const LocatableType> &type,
-                 std::vector<std::shared_ptr<const Type>> &visitedTypes) const;
+    bool shouldOutput(const std::shared_ptr<const LocatableType> &type,
+                      bool isUsed) const;
 
     /**
+     * @param isUsed true if typedef is used in one of printed declarations.
      * @return true if typedef will be printed.
      *         Following typedefs are not printed:
      *         - TypeDefs that should be imported from other bindings
@@ -167,9 +282,8 @@ class IR {
      *         - Unused typedefs from main header if they reference an opaque
      *           type
      */
-    bool shouldOutputTypeDef(
-        const std::shared_ptr<const TypeDef> &typeDef,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const;
+    bool shouldOutputTypeDef(const std::shared_ptr<const TypeDef> &typeDef,
+                             bool isUsed) const;
 
     /**
      * @tparam T one of LocatableType
@@ -180,10 +294,16 @@ class IR {
 
     std::string getHelperMethods() const;
 
+    /**
+     * @return true if at least one function-like macro is translated
+     */
+    bool hasTranslatedFunctionDefines() const;
+
     std::string libName;    // name of the library
     std::string linkName;   // name of the library to link with
     std::string objectName; // name of Scala object
-    const LocationManager &locationManager;
+    LocationManager &locationManager;
+    llvm::raw_ostream &diagnostics;
     std::vector<std::shared_ptr<Function>> functions;
     std::vector<std::shared_ptr<TypeDef>> typeDefs;
     std::vector<std::shared_ptr<Struct>> structs;
@@ -192,7 +312,23 @@ class IR {
     std::vector<std::shared_ptr<LiteralDefine>> literalDefines;
     std::vector<std::shared_ptr<PossibleVarDefine>> possibleVarDefines;
     std::vector<std::shared_ptr<VarDefine>> varDefines;
+    std::vector<std::string> possibleConstantDefines;
+    std::vector<std::shared_ptr<FunctionDefine>> functionDefines;
     std::vector<std::shared_ptr<Variable>> variables;
+    /* indexes for lookups by name, kept in sync with vectors above */
+    std::unordered_map<std::string, std::shared_ptr<Function>> functionsByName;
+    std::unordered_map<std::string, std::shared_ptr<TypeDef>> typeDefsByName;
+    std::unordered_map<std::string, std::shared_ptr<Enum>> enumsByName;
+    std::unordered_map<std::string, std::shared_ptr<Variable>>
+        variablesByName;
+    /* possible var defines by name of the variable */
+    std::unordered_map<std::string, std::shared_ptr<PossibleVarDefine>>
+        possibleVarDefinesByVar;
+    /* names of literal, var, possible var and function defines */
+    std::unordered_set<std::string> defineNames;
+    /* types that will be printed, see findOutputTypes */
+    std::unordered_set<const Type *> outputTypes;
+    TypeFactory typeFactory;
     bool generated = false; // generate type defs only once
     std::string packageName;
 };
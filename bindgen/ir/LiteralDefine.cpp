@@ -10,12 +10,19 @@ LiteralDefine::getDefinition(const LocationManager &locationManager) const {
            literal + "\n";
 }
 
-bool LiteralDefine::usesType(
-    const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool LiteralDefine::usesType(const std::shared_ptr<const Type> &type,
+                             bool stopOnTypeDefs,
+                             std::vector<const Type *> &visitedTypes) const {
     if (*this->type == *type) {
         return true;
     }
     visitedTypes.clear();
     return this->type->usesType(type, stopOnTypeDefs, visitedTypes);
 }
+
+void LiteralDefine::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes) const {
+    std::vector<const Type *> visitedTypes;
+    usedTypes.push_back(type);
+    type->collectUsedTypes(usedTypes, visitedTypes);
+}
@@ -13,7 +13,14 @@ class LiteralDefine : public Define {
     std::string getDefinition(const LocationManager &locationManager) const;
 
     bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-                  std::vector<std::shared_ptr<const Type>> &visitedTypes) const;
+                  std::vector<const Type *> &visitedTypes) const;
+
+    /**
+     * Add types that are used by the define to usedTypes.
+     * @see Type::collectUsedTypes
+     */
+    void
+    collectUsedTypes(std::vector<std::shared_ptr<const Type>> &usedTypes) const;
 
   private:
     std::string literal;
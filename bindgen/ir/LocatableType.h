@@ -8,6 +8,13 @@ class LocatableType : virtual public Type {
   public:
     explicit LocatableType(std::shared_ptr<Location> location);
 
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::Enum ||
+               type->getKind() == Kind::Union ||
+               type->getKind() == Kind::Struct ||
+               type->getKind() == Kind::TypeDef;
+    }
+
     virtual std::shared_ptr<Location> getLocation() const;
 
   protected:
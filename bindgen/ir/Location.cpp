@@ -1,8 +1,8 @@
 #include "Location.h"
 
-Location::Location(std::string path, int lineNumber)
-    : path(std::move(path)), lineNumber(lineNumber) {}
+Location::Location(unsigned fileIndex, int lineNumber)
+    : fileIndex(fileIndex), lineNumber(lineNumber) {}
 
-std::string Location::getPath() const { return path; }
+unsigned Location::getFileIndex() const { return fileIndex; }
 
 int Location::getLineNumber() const { return lineNumber; }
@@ -5,14 +5,17 @@
 
 class Location {
   public:
-    Location(std::string path, int lineNumber);
+    /**
+     * @param fileIndex index of the file, see LocationManager::getFileIndex
+     */
+    Location(unsigned fileIndex, int lineNumber);
 
-    std::string getPath() const;
+    unsigned getFileIndex() const;
 
     int getLineNumber() const;
 
   private:
-    std::string path; // may be empty
+    unsigned fileIndex;
     int lineNumber;
 };
 
@@ -2,22 +2,72 @@
 #include "../Utils.h"
 #include "Enum.h"
 #include "Struct.h"
+#include <fnmatch.h>
 #include <fstream>
 #include <stdexcept>
 
-LocationManager::LocationManager(std::string mainHeaderPath)
-    : mainHeaderPath(std::move(mainHeaderPath)) {}
+LocationManager::LocationManager(std::string mainHeaderPath) {
+    getFileIndex(mainHeaderPath);
+}
+
+unsigned LocationManager::getFileIndex(const std::string &path) {
+    auto it = fileIndexes.find(path);
+    if (it != fileIndexes.end()) {
+        return it->second;
+    }
+    auto index = static_cast<unsigned>(files.size());
+    files.push_back(path);
+    fileIndexes.emplace(path, index);
+    entriesByFile.push_back(findHeaderEntry(path));
+    return index;
+}
 
 void LocationManager::loadConfig(const std::string &path) {
     std::string realPath = getRealPath(path.c_str());
 
-    std::stringstream s;
     std::ifstream input(realPath);
-    for (std::string line; getline(input, line);) {
-        s << line;
-    }
-    config = json::parse(s.str());
+    json config = json::parse(input);
     validateConfig(config);
+    compileConfig(config);
+}
+
+void LocationManager::compileConfig(const json &config) {
+    headerEntries.clear();
+    entriesByFullPath.clear();
+    entriesBySuffix.clear();
+    entriesByGlob.clear();
+    for (auto it = config.begin(); it != config.end(); ++it) {
+        const json &value = it.value();
+        HeaderEntry headerEntry;
+        if (value.is_string()) {
+            headerEntry.object = value.get<std::string>();
+        } else {
+            headerEntry.object = value["object"].get<std::string>();
+            auto names = value.find("names");
+            if (names != value.end()) {
+                for (auto name = names->begin(); name != names->end();
+                     ++name) {
+                    headerEntry.names.emplace(name.key(),
+                                              name.value().get<std::string>());
+                }
+            }
+        }
+        size_t index = headerEntries.size();
+        headerEntries.push_back(std::move(headerEntry));
+
+        const std::string &pathToHeader = it.key();
+        if (pathToHeader.find_first_of("*?[") != std::string::npos) {
+            entriesByGlob.emplace_back(pathToHeader, index);
+        } else if (startsWith(pathToHeader, "/")) {
+            entriesByFullPath.emplace(pathToHeader, index);
+        } else {
+            entriesBySuffix.emplace(pathToHeader, index);
+        }
+    }
+    /* files that were added before the configuration was loaded */
+    for (size_t i = 0; i < files.size(); i++) {
+        entriesByFile[i] = findHeaderEntry(files[i]);
+    }
 }
 
 void LocationManager::validateConfig(const json &config) const {
@@ -92,47 +142,58 @@ void LocationManager::validateNames(const json &names) const {
 }
 
 bool LocationManager::inMainFile(const Location &location) const {
-    return location.getPath() == mainHeaderPath;
+    return location.getFileIndex() == 0;
 }
 
 bool LocationManager::isImported(const Location &location) const {
-    if (location.getPath().empty()) {
-        return false;
-    }
-    json headerEntry = getHeaderEntry(location);
-    return !headerEntry.empty();
+    return entriesByFile[location.getFileIndex()] != nullptr;
 }
 
-json LocationManager::getHeaderEntry(const Location &location) const {
-    for (auto it = config.begin(); it != config.end(); ++it) {
-        std::string pathToHeader = it.key();
-        if (startsWith(pathToHeader, "/")) {
-            /* full path */
-            if (location.getPath() == pathToHeader) {
-                return it.value();
+const LocationManager::HeaderEntry *
+LocationManager::findHeaderEntry(const std::string &path) const {
+    if (path.empty()) {
+        return nullptr;
+    }
+    auto fullPath = entriesByFullPath.find(path);
+    if (fullPath != entriesByFullPath.end()) {
+        return &headerEntries[fullPath->second];
+    }
+    /* suffixes start after a slash, the longest one is checked first */
+    for (size_t slash = path.find('/'); slash != std::string::npos;
+         slash = path.find('/', slash + 1)) {
+        auto suffix = entriesBySuffix.find(path.substr(slash + 1));
+        if (suffix != entriesBySuffix.end()) {
+            return &headerEntries[suffix->second];
+        }
+    }
+    for (const auto &glob : entriesByGlob) {
+        const std::string &pattern = glob.first;
+        if (startsWith(pattern, "/")) {
+            if (fnmatch(pattern.c_str(), path.c_str(), FNM_PATHNAME) == 0) {
+                return &headerEntries[glob.second];
+            }
+            continue;
+        }
+        for (size_t slash = path.find('/'); slash != std::string::npos;
+             slash = path.find('/', slash + 1)) {
+            if (fnmatch(pattern.c_str(), path.c_str() + slash + 1,
+                        FNM_PATHNAME) == 0) {
+                return &headerEntries[glob.second];
             }
-        } else if (endsWith(location.getPath(), "/" + pathToHeader)) {
-            return it.value();
         }
     }
-    return json::object();
+    return nullptr;
 }
 
 std::string LocationManager::getImportedType(const Location &location,
                                              const std::string &name) const {
-    json headerEntry = getHeaderEntry(location);
-    if (headerEntry.is_string()) {
-        return headerEntry.get<std::string>() + "." +
-               handleReservedWords(replaceChar(name, " ", "_"));
-    }
-    std::string scalaObject = headerEntry["object"];
-
-    if (headerEntry.find("names") != headerEntry.end()) {
+    const HeaderEntry *headerEntry = entriesByFile[location.getFileIndex()];
+    assert(headerEntry);
+    auto it = headerEntry->names.find(name);
+    if (it != headerEntry->names.end()) {
         /* name mapping */
-        json names = headerEntry["names"];
-        if (names.find(name) != names.end()) {
-            return scalaObject + "." + names[name].get<std::string>();
-        }
+        return headerEntry->object + "." + it->second;
     }
-    return scalaObject + "." + handleReservedWords(replaceChar(name, " ", "_"));
+    return headerEntry->object + "." +
+           handleReservedWords(replaceChar(name, " ", "_"));
 }
@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -15,6 +16,12 @@ class LocationManager {
 
     void loadConfig(const std::string &path);
 
+    /**
+     * @param path real path of the file, empty if it is unknown
+     * @return index of the file. Index of the main header is 0.
+     */
+    unsigned getFileIndex(const std::string &path);
+
     bool inMainFile(const Location &location) const;
 
     /**
@@ -26,10 +33,36 @@ class LocationManager {
                                 const std::string &name) const;
 
   private:
-    std::string mainHeaderPath;
-    json config;
+    /**
+     * Compiled entry of binding configuration.
+     */
+    struct HeaderEntry {
+        std::string object; // fully qualified name of Scala object
+        /* Scala names of C types */
+        std::unordered_map<std::string, std::string> names;
+    };
 
-    json getHeaderEntry(const Location &location) const;
+    /* real paths of files by index */
+    std::vector<std::string> files;
+    std::unordered_map<std::string, unsigned> fileIndexes;
+    /* entry for each file, nullptr if file is not imported */
+    std::vector<const HeaderEntry *> entriesByFile;
+    std::vector<HeaderEntry> headerEntries;
+    /* indexes of header entries by the key used in configuration */
+    std::unordered_map<std::string, size_t> entriesByFullPath;
+    std::unordered_map<std::string, size_t> entriesBySuffix;
+    std::vector<std::pair<std::string, size_t>> entriesByGlob;
+
+    void compileConfig(const json &config);
+
+    /**
+     * Entry is matched in following order:
+     * - key that is equal to the full path
+     * - the longest key that is a suffix of the path
+     * - the first glob pattern that matches the full path or a suffix of
+     *   the path
+     */
+    const HeaderEntry *findHeaderEntry(const std::string &path) const;
 
     void validateConfig(const json &config) const;
 
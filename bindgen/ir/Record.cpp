@@ -9,21 +9,42 @@ Field::Field(std::string name, std::shared_ptr<const Type> type,
     : TypeAndName(std::move(name), std::move(type)),
       offsetInBits(offsetInBits) {}
 
+Field::Field(std::string name, std::shared_ptr<const Type> type,
+             uint64_t offsetInBits, unsigned bitFieldWidth)
+    : TypeAndName(std::move(name), std::move(type)),
+      offsetInBits(offsetInBits), bitFieldWidth(bitFieldWidth) {}
+
 uint64_t Field::getOffsetInBits() const { return offsetInBits; }
 
+bool Field::isBitField() const { return bitFieldWidth > 0; }
+
+unsigned Field::getBitFieldWidth() const { return bitFieldWidth; }
+
+const std::vector<std::shared_ptr<const Struct>> &
+Field::getStructsThatBreakCycle() const {
+    return structsThatBreakCycle;
+}
+
+void Field::setStructsThatBreakCycle(
+    std::vector<std::shared_ptr<const Struct>> structsThatBreakCycle) {
+    this->structsThatBreakCycle = std::move(structsThatBreakCycle);
+    /* types of fields are printed differently */
+    Type::invalidateCachedStrs();
+}
+
 Record::Record(std::string name, std::vector<std::shared_ptr<Field>> fields,
-               std::shared_ptr<Location> location)
+               std::shared_ptr<Location> location, TypeFactory &typeFactory)
     : LocatableType(std::move(location)), name(std::move(name)),
-      fields(std::move(fields)) {}
+      fields(std::move(fields)), typeFactory(typeFactory) {}
 
-bool Record::usesType(
-    const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool Record::usesType(const std::shared_ptr<const Type> &type,
+                      bool stopOnTypeDefs,
+                      std::vector<const Type *> &visitedTypes) const {
 
     if (contains(this, visitedTypes)) {
         return false;
     }
-    visitedTypes.push_back(shared_from_this());
+    visitedTypes.push_back(this);
 
     for (const auto &field : fields) {
         if (*field->getType() == *type ||
@@ -36,6 +57,24 @@ bool Record::usesType(
     return false;
 }
 
+void Record::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes,
+    std::vector<const Type *> &visitedTypes) const {
+    if (contains(this, visitedTypes)) {
+        return;
+    }
+    visitedTypes.push_back(this);
+    for (const auto &field : fields) {
+        usedTypes.push_back(field->getType());
+        field->getType()->collectUsedTypes(usedTypes, visitedTypes);
+    }
+    visitedTypes.pop_back();
+}
+
 std::string Record::getName() const { return name; }
 
+const std::vector<std::shared_ptr<Field>> &Record::getFields() const {
+    return fields;
+}
+
 bool Record::hasHelperMethods() const { return !fields.empty(); }
@@ -14,19 +14,53 @@ class Field : public TypeAndName {
     Field(std::string name, std::shared_ptr<const Type> type,
           uint64_t offsetInBits);
 
+    /**
+     * @param bitFieldWidth width of bit field in bits
+     */
+    Field(std::string name, std::shared_ptr<const Type> type,
+          uint64_t offsetInBits, unsigned bitFieldWidth);
+
     uint64_t getOffsetInBits() const;
 
+    bool isBitField() const;
+
+    unsigned getBitFieldWidth() const;
+
+    /**
+     * @return structs which pointers should be replaced with pointers to Byte
+     *         in the type of this field in order to break a cycle of types.
+     *         Empty if the field does not break a cycle
+     *         (see IR::findFieldsThatBreakCycles).
+     */
+    const std::vector<std::shared_ptr<const Struct>> &
+    getStructsThatBreakCycle() const;
+
+    void setStructsThatBreakCycle(
+        std::vector<std::shared_ptr<const Struct>> structsThatBreakCycle);
+
   protected:
     /**
      * Offset in bytes from address of struct/union.
      */
     uint64_t offsetInBits = 0;
+    /* 0 if the field is not a bit field */
+    unsigned bitFieldWidth = 0;
+    std::vector<std::shared_ptr<const Struct>> structsThatBreakCycle;
 };
 
 class Record : public LocatableType {
   public:
+    /**
+     * @param typeFactory factory of IR that contains the record, it
+     *                    creates types of generated typedefs and accessors
+     */
     Record(std::string name, std::vector<std::shared_ptr<Field>> fields,
-           std::shared_ptr<Location> location);
+           std::shared_ptr<Location> location, TypeFactory &typeFactory);
+
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::Struct ||
+               type->getKind() == Kind::Union;
+    }
 
     virtual std::shared_ptr<TypeDef> generateTypeDef() = 0;
 
@@ -35,17 +69,23 @@ class Record : public LocatableType {
 
     std::string getName() const;
 
+    const std::vector<std::shared_ptr<Field>> &getFields() const;
+
     virtual std::string getTypeName() const = 0;
 
     virtual bool hasHelperMethods() const;
 
-    bool usesType(
-        const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
+                  std::vector<const Type *> &visitedTypes) const override;
+
+    void collectUsedTypes(
+        std::vector<std::shared_ptr<const Type>> &usedTypes,
+        std::vector<const Type *> &visitedTypes) const override;
 
   protected:
     std::string name; // does not contain 'struct' or 'union' word
     std::vector<std::shared_ptr<Field>> fields;
+    TypeFactory &typeFactory;
 };
 
 #endif // SCALA_NATIVE_BINDGEN_RECORD_H
@@ -5,26 +5,190 @@
 #include "types/FunctionPointerType.h"
 #include "types/PointerType.h"
 #include "types/PrimitiveType.h"
+#include "types/TypeFactory.h"
+#include <iomanip>
 #include <sstream>
 
+namespace {
+
+/**
+ * The smallest aligned integer that contains a bit field.
+ * Accessors of the bit field load this integer once.
+ *
+ * Fields of packed structs are not aligned, therefore the integer starts
+ * at the first byte of the field and it is copied with memcpy.
+ */
+struct BitFieldStorage {
+    BitFieldStorage(const Field &field, bool isPacked, uint64_t structSize) {
+        uint64_t first = field.getOffsetInBits();
+        uint64_t last = first + field.getBitFieldWidth() - 1;
+        sizeInBits = 8;
+        if (isPacked) {
+            while (sizeInBits < 64 && first / 8 + sizeInBits / 8 <= last / 8) {
+                sizeInBits *= 2;
+            }
+            offsetInBytes = first / 8;
+            if (offsetInBytes + sizeInBits / 8 > structSize &&
+                structSize >= sizeInBits / 8) {
+                /* the integer should not exceed the struct */
+                offsetInBytes = structSize - sizeInBits / 8;
+            }
+        } else {
+            while (sizeInBits < 64 &&
+                   first / sizeInBits != last / sizeInBits) {
+                sizeInBits *= 2;
+            }
+            offsetInBytes = first / sizeInBits * sizeInBits / 8;
+        }
+        shift = static_cast<unsigned>(first - offsetInBytes * 8);
+        fits = shift + field.getBitFieldWidth() <= sizeInBits &&
+               offsetInBytes + sizeInBits / 8 <= structSize;
+        /* bits are computed in Int unless the storage is Long */
+        isLong = sizeInBits == 64;
+        /* Byte is always aligned */
+        isUnaligned = isPacked && sizeInBits > 8;
+    }
+
+    std::string getType() const {
+        switch (sizeInBits) {
+        case 8:
+            return "Byte";
+        case 16:
+            return "native.CShort";
+        case 32:
+            return "native.CInt";
+        default:
+            return "native.CLong";
+        }
+    }
+
+    /**
+     * @return bits of the integer in Int or Long
+     */
+    std::string load(const std::string &pointer) const {
+        std::string value = "(!" + pointer + ")";
+        if (sizeInBits < 32) {
+            value += ".toInt";
+        }
+        return value;
+    }
+
+    /**
+     * @return conversion of Int or Long to the type of the storage
+     */
+    std::string store(const std::string &value) const {
+        if (sizeInBits > 16) {
+            return value;
+        }
+        std::string conversion = sizeInBits == 8 ? ".toByte" : ".toShort";
+        if (value.find(' ') == std::string::npos) {
+            return value + conversion;
+        }
+        return "(" + value + ")" + conversion;
+    }
+
+    /**
+     * @return hexadecimal Int or Long literal
+     */
+    std::string literal(uint64_t value) const {
+        std::stringstream s;
+        if (!isLong) {
+            value &= 0xffffffff;
+        }
+        s << "0x" << std::hex << value << (isLong ? "L" : "");
+        return s.str();
+    }
+
+    unsigned bitsInValue() const { return isLong ? 64 : 32; }
+
+    uint64_t offsetInBytes;
+    unsigned sizeInBits;
+    /* offset of the field in the storage */
+    unsigned shift;
+    bool isLong;
+    /* true if the integer is copied with memcpy */
+    bool isUnaligned;
+    /* false if the field is not contained in an integer that does
+     * not exceed the struct. It may happen in packed structs */
+    bool fits;
+};
+
+/**
+ * @return call of memcpy that copies a value of given type.
+ *         Unlike load and store memcpy does not require aligned addresses
+ */
+std::string copyValue(const std::string &to, const std::string &from,
+                      const std::string &type) {
+    return "native.string.memcpy(" + to + ", " + from + ", native.sizeof[" +
+           type + "])";
+}
+
+/**
+ * @return name of primitive type of a bit field. Enums are
+ *         replaced by their integer types
+ */
+std::string getBitFieldTypeName(const Field &field, TypeFactory &typeFactory) {
+    std::shared_ptr<const Type> type =
+        field.getType()->unrollTypedefs(typeFactory);
+    if (auto *primitiveType = dyn_cast<PrimitiveType>(type.get())) {
+        return primitiveType->getType();
+    }
+    return "";
+}
+
+bool isUnsignedBitField(const std::string &typeName) {
+    return typeName.find("Unsigned") != std::string::npos ||
+           typeName == "native.CChar16" || typeName == "native.CChar32";
+}
+
+/**
+ * @return conversion of Int or Long to type of a bit field
+ */
+std::string getBitFieldConversion(const std::string &typeName, bool isLong) {
+    if (typeName == "native.CInt" || typeName == "native.CWideChar") {
+        return isLong ? ".toInt" : "";
+    } else if (typeName == "native.CLong" || typeName == "native.CLongLong") {
+        return isLong ? "" : ".toLong";
+    } else if (typeName == "native.CChar" ||
+               typeName == "native.CSignedChar") {
+        return ".toByte";
+    } else if (typeName == "native.CShort") {
+        return ".toShort";
+    } else if (typeName == "native.CUnsignedChar") {
+        return ".toUByte";
+    } else if (typeName == "native.CUnsignedShort" ||
+               typeName == "native.CChar16") {
+        return ".toUShort";
+    } else if (typeName == "native.CUnsignedInt" ||
+               typeName == "native.CChar32") {
+        return ".toUInt";
+    }
+    /* native.CUnsignedLong and native.CUnsignedLongLong. Int is converted
+     * to UInt first, otherwise its highest bit would be extended */
+    return isLong ? ".toULong" : ".toUInt.toULong";
+}
+
+} // namespace
+
 Struct::Struct(std::string name, std::vector<std::shared_ptr<Field>> fields,
                uint64_t typeSize, std::shared_ptr<Location> location,
-               bool isPacked, bool isBitField)
-    : Record(std::move(name), std::move(fields), std::move(location)),
+               bool isPacked, bool isBitField, TypeFactory &typeFactory)
+    : Type(Kind::Struct), Record(std::move(name), std::move(fields),
+                                 std::move(location), typeFactory),
       typeSize(typeSize), isPacked(isPacked), hasBitField(isBitField) {}
 
 std::shared_ptr<TypeDef> Struct::generateTypeDef() {
     if (isRepresentedAsStruct()) {
-        return std::make_shared<TypeDef>(getTypeName(), shared_from_this(),
-                                         nullptr);
+        return typeFactory.getArena().make<TypeDef>(
+            getTypeName(), shared_from_this(), nullptr);
     } else {
         // There is no easy way to represent it as a struct in scala native,
         // have to represent it as an array and then Add helpers to help with
         // its manipulation
-        return std::make_shared<TypeDef>(
+        return typeFactory.getArena().make<TypeDef>(
             getTypeName(),
-            std::make_shared<ArrayType>(std::make_shared<PrimitiveType>("Byte"),
-                                        typeSize),
+            typeFactory.getArrayType(typeFactory.getPrimitiveType("Byte"),
+                                     typeSize),
             location);
     }
 }
@@ -48,13 +212,18 @@ Struct::generateHelperClass(const LocationManager &locationManager) const {
 }
 
 bool Struct::hasHelperMethods() const {
-    if (hasBitField) {
-        return false;
-    }
-    if (!isRepresentedAsStruct()) {
-        return !fields.empty();
+    return !fields.empty() && getBitFieldThatDoesNotFit().empty();
+}
+
+std::string Struct::getBitFieldThatDoesNotFit() const {
+    for (const auto &field : fields) {
+        /* accessors are not generated for padding bit fields */
+        if (field->isBitField() && !field->getName().empty() &&
+            !BitFieldStorage(*field, isPacked, typeSize).fits) {
+            return field->getName();
+        }
     }
-    return !isPacked && !fields.empty();
+    return "";
 }
 
 std::string Struct::generateHelperClassMethodsForStructRepresentation(
@@ -88,14 +257,18 @@ std::string Struct::generateHelperClassMethodsForArrayRepresentation(
 std::string Struct::getTypeName() const { return "struct " + name; }
 
 std::string Struct::str(const LocationManager &locationManager) const {
+    if (const std::string *cached = getCachedStr(locationManager)) {
+        return *cached;
+    }
     std::stringstream ss;
     ss << "native.CStruct" << std::to_string(fields.size()) << "[";
 
     std::string sep = "";
     for (const auto &field : fields) {
         ss << sep;
-        std::vector<std::shared_ptr<const Struct>>
-            structTypesThatShouldBeReplaced = shouldFieldBreakCycle(field);
+        const std::vector<std::shared_ptr<const Struct>>
+            &structTypesThatShouldBeReplaced =
+                field->getStructsThatBreakCycle();
         if (structTypesThatShouldBeReplaced.empty()) {
             ss << field->getType()->str(locationManager);
         } else {
@@ -108,15 +281,14 @@ std::string Struct::str(const LocationManager &locationManager) const {
     }
 
     ss << "]";
-    return ss.str();
+    return setCachedStr(locationManager, ss.str());
 }
 
 bool Struct::operator==(const Type &other) const {
     if (this == &other) {
         return true;
     }
-    auto *s = dynamic_cast<const Struct *>(&other);
-    if (s) {
+    if (auto *s = dyn_cast<Struct>(&other)) {
         /* structs have unique names */
         return name == s->name;
     }
@@ -125,13 +297,13 @@ bool Struct::operator==(const Type &other) const {
 
 std::string Struct::generateSetterForStructRepresentation(
     unsigned fieldIndex, const LocationManager &locationManager) const {
-    std::shared_ptr<Field> field = fields[fieldIndex];
+    const std::shared_ptr<Field> &field = fields[fieldIndex];
     std::string setter = handleReservedWords(field->getName(), "_=");
     std::string parameterType =
         wrapArrayOrRecordInPointer(field->getType())->str(locationManager);
     std::string value = "value";
-    std::vector<std::shared_ptr<const Struct>> structTypesThatShouldBeReplaced =
-        shouldFieldBreakCycle(field);
+    const std::vector<std::shared_ptr<const Struct>>
+        &structTypesThatShouldBeReplaced = field->getStructsThatBreakCycle();
     if (!structTypesThatShouldBeReplaced.empty()) {
         /* field type is changed to avoid cyclic types in generated code */
         std::shared_ptr<const Type> typeReplacement = getTypeReplacement(
@@ -148,14 +320,14 @@ std::string Struct::generateSetterForStructRepresentation(
 
 std::string Struct::generateGetterForStructRepresentation(
     unsigned fieldIndex, const LocationManager &locationManager) const {
-    std::shared_ptr<Field> field = fields[fieldIndex];
+    const std::shared_ptr<Field> &field = fields[fieldIndex];
     std::string getter = handleReservedWords(field->getName());
     std::string returnType =
         wrapArrayOrRecordInPointer(field->getType())->str(locationManager);
     std::string methodBody = "p._" + std::to_string(fieldIndex + 1);
     if (!isArrayOrRecord(field->getType())) {
         methodBody = "!" + methodBody;
-        if (!shouldFieldBreakCycle(field).empty()) {
+        if (!field->getStructsThatBreakCycle().empty()) {
             /* field type is changed to avoid cyclic types in generated code */
             methodBody = "(" + methodBody + ").cast[" +
                          field->getType()->str(locationManager) + "]";
@@ -168,12 +340,20 @@ std::string Struct::generateGetterForStructRepresentation(
 }
 
 bool Struct::isRepresentedAsStruct() const {
-    return fields.size() <= SCALA_NATIVE_MAX_STRUCT_FIELDS && !hasBitField;
+    /* Scala Native aligns fields of CStruct */
+    return fields.size() <= SCALA_NATIVE_MAX_STRUCT_FIELDS && !hasBitField &&
+           !isPacked;
 }
 
 std::string Struct::generateSetterForArrayRepresentation(
     unsigned int fieldIndex, const LocationManager &locationManager) const {
-    std::shared_ptr<Field> field = fields[fieldIndex];
+    const std::shared_ptr<Field> &field = fields[fieldIndex];
+    if (field->isBitField()) {
+        return generateSetterForBitField(fieldIndex, locationManager);
+    }
+    if (isPacked) {
+        return generateUnalignedSetter(fieldIndex, locationManager);
+    }
     std::string setter = handleReservedWords(field->getName(), "_=");
     std::string parameterType =
         wrapArrayOrRecordInPointer(field->getType())->str(locationManager);
@@ -188,8 +368,8 @@ std::string Struct::generateSetterForArrayRepresentation(
     }
     castedField = "!" + castedField + ".cast[" +
                   pointerToFieldType.str(locationManager) + "]";
-    std::vector<std::shared_ptr<const Struct>> structTypesThatShouldBeReplaced =
-        shouldFieldBreakCycle(field);
+    const std::vector<std::shared_ptr<const Struct>>
+        &structTypesThatShouldBeReplaced = field->getStructsThatBreakCycle();
     if (!structTypesThatShouldBeReplaced.empty()) {
         /* field type is changed to avoid cyclic types in generated code */
         std::shared_ptr<const Type> typeReplacement = getTypeReplacement(
@@ -207,7 +387,13 @@ std::string Struct::generateSetterForArrayRepresentation(
 
 std::string Struct::generateGetterForArrayRepresentation(
     unsigned fieldIndex, const LocationManager &locationManager) const {
-    std::shared_ptr<Field> field = fields[fieldIndex];
+    const std::shared_ptr<Field> &field = fields[fieldIndex];
+    if (field->isBitField()) {
+        return generateGetterForBitField(fieldIndex, locationManager);
+    }
+    if (isPacked && !isArrayOrRecord(field->getType())) {
+        return generateUnalignedGetter(fieldIndex, locationManager);
+    }
     std::string getter = handleReservedWords(field->getName());
     std::string returnType =
         wrapArrayOrRecordInPointer(field->getType())->str(locationManager);
@@ -225,7 +411,7 @@ std::string Struct::generateGetterForArrayRepresentation(
 
     if (!isArrayOrRecord(field->getType())) {
         methodBody = "!" + methodBody;
-        if (!shouldFieldBreakCycle(field).empty()) {
+        if (!field->getStructsThatBreakCycle().empty()) {
             /* field type is changed to avoid cyclic types in generated code */
             methodBody = "(" + methodBody + ").cast[" +
                          field->getType()->str(locationManager) + "]";
@@ -237,109 +423,239 @@ std::string Struct::generateGetterForArrayRepresentation(
     return s.str();
 }
 
+std::string Struct::getFieldPointer(uint64_t offsetInBytes) const {
+    if (offsetInBytes > 0) {
+        return "(p._1 + " + std::to_string(offsetInBytes) + ")";
+    }
+    return "p._1";
+}
+
+std::string Struct::generateUnalignedGetter(
+    unsigned fieldIndex, const LocationManager &locationManager) const {
+    const std::shared_ptr<Field> &field = fields[fieldIndex];
+    std::string fieldType = field->getType()->str(locationManager);
+    std::string storedType = fieldType;
+    std::string value = "!value";
+    const std::vector<std::shared_ptr<const Struct>>
+        &structTypesThatShouldBeReplaced = field->getStructsThatBreakCycle();
+    if (!structTypesThatShouldBeReplaced.empty()) {
+        /* field type is changed to avoid cyclic types in generated code */
+        storedType = getTypeReplacement(field->getType(),
+                                        structTypesThatShouldBeReplaced)
+                         ->str(locationManager);
+        value = "(" + value + ").cast[" + fieldType + "]";
+    }
+    std::stringstream s;
+    s << "      def " << handleReservedWords(field->getName()) << ": "
+      << fieldType << " = {\n"
+      << "        val value = native.stackalloc[" << storedType << "]\n"
+      << "        "
+      << copyValue("value.cast[native.Ptr[Byte]]",
+                   getFieldPointer(field->getOffsetInBits() / 8), storedType)
+      << "\n"
+      << "        " << value << "\n"
+      << "      }\n";
+    return s.str();
+}
+
+std::string Struct::generateUnalignedSetter(
+    unsigned fieldIndex, const LocationManager &locationManager) const {
+    const std::shared_ptr<Field> &field = fields[fieldIndex];
+    std::string setter = handleReservedWords(field->getName(), "_=");
+    std::string parameterType =
+        wrapArrayOrRecordInPointer(field->getType())->str(locationManager);
+    std::string fieldPointer = getFieldPointer(field->getOffsetInBits() / 8);
+    std::stringstream s;
+    if (isArrayOrRecord(field->getType())) {
+        s << "      def " << setter << "(value: " << parameterType
+          << "): Unit = "
+          << copyValue(fieldPointer, "value.cast[native.Ptr[Byte]]",
+                       field->getType()->str(locationManager))
+          << "\n";
+        return s.str();
+    }
+    std::string storedType = parameterType;
+    std::string value = "value";
+    const std::vector<std::shared_ptr<const Struct>>
+        &structTypesThatShouldBeReplaced = field->getStructsThatBreakCycle();
+    if (!structTypesThatShouldBeReplaced.empty()) {
+        /* field type is changed to avoid cyclic types in generated code */
+        storedType = getTypeReplacement(field->getType(),
+                                        structTypesThatShouldBeReplaced)
+                         ->str(locationManager);
+        value = value + ".cast[" + storedType + "]";
+    }
+    s << "      def " << setter << "(value: " << parameterType
+      << "): Unit = {\n"
+      << "        val ptr = native.stackalloc[" << storedType << "]\n"
+      << "        !ptr = " << value << "\n"
+      << "        "
+      << copyValue(fieldPointer, "ptr.cast[native.Ptr[Byte]]", storedType)
+      << "\n"
+      << "      }\n";
+    return s.str();
+}
+
+std::string Struct::generateGetterForBitField(
+    unsigned fieldIndex, const LocationManager &locationManager) const {
+    const std::shared_ptr<Field> &field = fields[fieldIndex];
+    BitFieldStorage storage(*field, isPacked, typeSize);
+    std::string typeName = getBitFieldTypeName(*field, typeFactory);
+    unsigned width = field->getBitFieldWidth();
+    unsigned bits = storage.bitsInValue();
+    std::string storagePointer = getFieldPointer(storage.offsetInBytes);
+
+    std::string value = storage.load(
+        storage.isUnaligned
+            ? "ptr"
+            : storagePointer + ".cast[native.Ptr[" + storage.getType() + "]]");
+    if (typeName == "native.CBool" || isUnsignedBitField(typeName)) {
+        if (storage.shift > 0) {
+            value =
+                "(" + value + " >>> " + std::to_string(storage.shift) + ")";
+        }
+        if (width < bits) {
+            value = "(" + value + " & " +
+                    storage.literal((uint64_t(1) << width) - 1) + ")";
+        }
+    } else {
+        /* the highest bit of the field is moved to the sign bit and
+         * arithmetic shift extends it */
+        unsigned leftShift = bits - storage.shift - width;
+        if (leftShift > 0) {
+            value = "(" + value + " << " + std::to_string(leftShift) + ")";
+        }
+        if (width < bits) {
+            value =
+                "(" + value + " >> " + std::to_string(bits - width) + ")";
+        }
+    }
+    if (typeName == "native.CBool") {
+        value += " != 0";
+    } else {
+        value += getBitFieldConversion(typeName, storage.isLong);
+    }
+
+    std::stringstream s;
+    s << "      def " << handleReservedWords(field->getName()) << ": "
+      << field->getType()->str(locationManager) << " = ";
+    if (storage.isUnaligned) {
+        s << "{\n"
+          << "        val ptr = native.stackalloc[" << storage.getType()
+          << "]\n"
+          << "        "
+          << copyValue("ptr.cast[native.Ptr[Byte]]", storagePointer,
+                       storage.getType())
+          << "\n"
+          << "        " << value << "\n"
+          << "      }\n";
+    } else {
+        s << value << "\n";
+    }
+    return s.str();
+}
+
+std::string Struct::generateSetterForBitField(
+    unsigned fieldIndex, const LocationManager &locationManager) const {
+    const std::shared_ptr<Field> &field = fields[fieldIndex];
+    BitFieldStorage storage(*field, isPacked, typeSize);
+    std::string typeName = getBitFieldTypeName(*field, typeFactory);
+    unsigned width = field->getBitFieldWidth();
+    std::string storagePointer = getFieldPointer(storage.offsetInBytes);
+
+    std::string value = "value";
+    if (typeName == "native.CBool") {
+        value = storage.isLong ? "(if (value) 1L else 0L)"
+                               : "(if (value) 1 else 0)";
+    } else if (storage.isLong) {
+        if (getBitFieldConversion(typeName, true) != "") {
+            value += ".toLong";
+        }
+    } else if (getBitFieldConversion(typeName, false) != "") {
+        value += ".toInt";
+    }
+
+    std::string storedValue;
+    bool occupiesStorage = width == storage.sizeInBits;
+    if (occupiesStorage) {
+        storedValue = storage.store(value);
+    } else {
+        uint64_t mask = (uint64_t(1) << width) - 1;
+        if (typeName != "native.CBool") {
+            value = "(" + value + " & " + storage.literal(mask) + ")";
+        }
+        if (storage.shift > 0) {
+            value = "(" + value + " << " + std::to_string(storage.shift) + ")";
+        }
+        storedValue = storage.store(
+            "(" + storage.load("ptr") + " & " +
+            storage.literal(~(mask << storage.shift)) + ") | " + value);
+    }
+
+    std::stringstream s;
+    s << "      def " << handleReservedWords(field->getName(), "_=")
+      << "(value: " << field->getType()->str(locationManager)
+      << "): Unit = {\n";
+    if (storage.isUnaligned) {
+        s << "        val ptr = native.stackalloc[" << storage.getType()
+          << "]\n";
+        if (!occupiesStorage) {
+            s << "        "
+              << copyValue("ptr.cast[native.Ptr[Byte]]", storagePointer,
+                           storage.getType())
+              << "\n";
+        }
+        s << "        !ptr = " << storedValue << "\n"
+          << "        "
+          << copyValue(storagePointer, "ptr.cast[native.Ptr[Byte]]",
+                       storage.getType())
+          << "\n";
+    } else {
+        s << "        val ptr = " << storagePointer << ".cast[native.Ptr["
+          << storage.getType() << "]]\n"
+          << "        !ptr = " << storedValue << "\n";
+    }
+    s << "      }\n";
+    return s.str();
+}
+
 std::shared_ptr<const Type>
-Struct::getTypeReplacement(std::shared_ptr<const Type> type,
-                           std::vector<std::shared_ptr<const Struct>>
-                               structTypesThatShouldBeReplaced) const {
-    std::shared_ptr<const Type> replacementType = type->unrollTypedefs();
+Struct::getTypeReplacement(const std::shared_ptr<const Type> &type,
+                           const std::vector<std::shared_ptr<const Struct>>
+                               &structTypesThatShouldBeReplaced) const {
+    std::shared_ptr<const Type> replacementType =
+        type->unrollTypedefs(typeFactory);
     std::shared_ptr<PointerType> pointerToByte =
-        std::make_shared<PointerType>(std::make_shared<PrimitiveType>("Byte"));
+        typeFactory.getPointerType(typeFactory.getPrimitiveType("Byte"));
     for (const auto &recordType : structTypesThatShouldBeReplaced) {
-        std::shared_ptr<TypeDef> recordTypeDef = std::make_shared<TypeDef>(
-            recordType->getTypeName(), recordType, nullptr);
+        std::shared_ptr<TypeDef> recordTypeDef =
+            typeFactory.getArena().make<TypeDef>(recordType->getTypeName(),
+                                                 recordType, nullptr);
         std::shared_ptr<Type> pointerToRecord =
-            std::make_shared<PointerType>(recordTypeDef);
+            typeFactory.getPointerType(recordTypeDef);
         if (*replacementType == *pointerToRecord) {
             replacementType = pointerToByte;
         } else {
-            replacementType =
-                replacementType->replaceType(pointerToRecord, pointerToByte);
+            replacementType = replacementType->replaceType(
+                pointerToRecord, pointerToByte, typeFactory);
         }
-        std::vector<std::shared_ptr<const Type>> visitedTypes;
+        std::vector<const Type *> visitedTypes;
         if (replacementType->usesType(recordType, false, visitedTypes)) {
-            assert(isInstanceOf<FunctionPointerType>(replacementType.get()));
+            assert(isa<FunctionPointerType>(replacementType));
             /* function pointer types may have return value or a parameter of
              * value type */
             replacementType = replacementType->replaceType(
-                recordTypeDef,
-                std::make_shared<PrimitiveType>("native.CStruct0"));
+                recordTypeDef, typeFactory.getPrimitiveType("native.CStruct0"),
+                typeFactory);
         }
     }
     return replacementType;
 }
 
-std::vector<std::shared_ptr<const Struct>>
-Struct::shouldFieldBreakCycle(const std::shared_ptr<Field> &field) const {
-    std::vector<std::shared_ptr<const Struct>> structTypesThatShouldBeReplaced;
-    if (isAliasForType<Struct>(field->getType().get()) ||
-        isAliasForType<Union>(field->getType().get())) {
-        /* cycle should be broken on pointer type */
-        return structTypesThatShouldBeReplaced;
-    }
-    CycleNode baseNode(shared_from_base<Struct>(), field.get());
-    std::vector<std::shared_ptr<const Type>> visitedTypes;
-    if (field->getType()->findAllCycles(shared_from_base<Struct>(), baseNode,
-                                        visitedTypes)) {
-        /* one or more cycles were found but type of the filed should be
-         * changed if this struct has the biggest name compared to other structs
-         * in cycle that have fields of non-value type.
-         */
-        if (baseNode.cycleNodes.empty()) {
-            /* field references containing struct */
-            structTypesThatShouldBeReplaced.push_back(
-                shared_from_base<Struct>());
-        }
-        for (const auto &nextCycleNode : baseNode.cycleNodes) {
-            std::vector<std::string> namesInCycle;
-            if (hasBiggestName(nextCycleNode, namesInCycle)) {
-                structTypesThatShouldBeReplaced.push_back(nextCycleNode.s);
-            }
-        }
-    }
-    return structTypesThatShouldBeReplaced;
-}
-
-bool Struct::findAllCycles(
-    const std::shared_ptr<const Struct> &startStruct, CycleNode &cycleNode,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
-    if (this == startStruct.get()) {
-        return true;
-    }
-    /* visitedTypes check is ignored because it is not necessary to save Struct
-     * and Union types in visitedTypes if it is done for TypeDefs (Struct and
-     * Union types can be references only through TypeDefs) */
-    bool belongsToCycle = false;
-    for (const auto &field : fields) {
-        CycleNode newCycleNode(shared_from_base<Struct>(), field.get());
-        if (field->getType()->findAllCycles(startStruct, newCycleNode,
-                                            visitedTypes)) {
-            if (isAliasForType<Struct>(field->getType().get()) ||
-                isAliasForType<Union>(field->getType().get())) {
-                /* cycles cannot be broken on value type fields */
-                newCycleNode.isValueType = true;
-            }
-            belongsToCycle = true;
-            cycleNode.cycleNodes.push_back(newCycleNode);
-        }
-    }
-    return belongsToCycle;
-}
-
-bool Struct::hasBiggestName(const CycleNode &node,
-                            std::vector<std::string> namesInCycle) const {
-    if (!node.isValueType) {
-        namesInCycle.push_back(node.s->getTypeName());
-    }
-    if (node.cycleNodes.empty()) {
-        std::sort(namesInCycle.begin(), namesInCycle.end());
-        return getTypeName() >= namesInCycle.back();
-    }
-    for (const auto &cycleNode : node.cycleNodes) {
-        if (hasBiggestName(cycleNode, namesInCycle)) {
-            return true;
-        }
-    }
-    return false;
+void Struct::collectReferencedStructs(
+    std::vector<std::shared_ptr<const Struct>> &structs,
+    std::vector<const Type *> &visitedTypes) const {
+    structs.push_back(shared_from_base<Struct>());
 }
 
 std::string
@@ -357,6 +673,10 @@ Struct::getConstructorHelper(const LocationManager &locationManager) const {
     s << "    def apply(";
     std::string sep = "";
     for (const auto &field : fields) {
+        if (field->getName().empty()) {
+            /* padding bit fields */
+            continue;
+        }
         s << sep << handleReservedWords(field->getName()) << ": "
           << wrapArrayOrRecordInPointer(field->getType())->str(locationManager);
         sep = ", ";
@@ -364,6 +684,9 @@ Struct::getConstructorHelper(const LocationManager &locationManager) const {
     s << ")(implicit z: native.Zone): native.Ptr[" << type << "] = {\n"
       << "      val ptr = native.alloc[" << type << "]\n";
     for (const auto &field : fields) {
+        if (field->getName().empty()) {
+            continue;
+        }
         std::string name = handleReservedWords(field->getName());
         s << "      ptr." << name << " = " << name << "\n";
     }
@@ -373,15 +696,15 @@ Struct::getConstructorHelper(const LocationManager &locationManager) const {
     return s.str();
 }
 
-bool Struct::isArrayOrRecord(std::shared_ptr<const Type> type) const {
+bool Struct::isArrayOrRecord(const std::shared_ptr<const Type> &type) const {
     return isAliasForType<ArrayType>(type.get()) ||
            isAliasForType<Struct>(type.get());
 }
 
-std::shared_ptr<const Type>
-Struct::wrapArrayOrRecordInPointer(std::shared_ptr<const Type> type) const {
+std::shared_ptr<const Type> Struct::wrapArrayOrRecordInPointer(
+    const std::shared_ptr<const Type> &type) const {
     if (isArrayOrRecord(type)) {
-        return std::make_shared<PointerType>(type);
+        return typeFactory.getPointerType(type);
     }
     return type;
 }
@@ -9,7 +9,11 @@ class Struct : public Record {
   public:
     Struct(std::string name, std::vector<std::shared_ptr<Field>> fields,
            uint64_t typeSize, std::shared_ptr<Location> location, bool isPacked,
-           bool isBitField);
+           bool isBitField, TypeFactory &typeFactory);
+
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::Struct;
+    }
 
     std::shared_ptr<TypeDef> generateTypeDef() override;
 
@@ -23,23 +27,20 @@ class Struct : public Record {
      */
     bool hasHelperMethods() const override;
 
+    /**
+     * @return name of the first bit field that is not contained in
+     *         an integer inside the struct or empty string.
+     *         Helper methods are not generated if there is such field
+     */
+    std::string getBitFieldThatDoesNotFit() const;
+
     std::string str(const LocationManager &locationManager) const override;
 
     bool operator==(const Type &other) const override;
 
-    /**
-     * If the struct belongs to one or more cycles that contain
-     * startStruct then field(s) that causes cycle(s) will be added to
-     * cycleNode.cycleNodes (as well as all other fields further in this cycle).
-     * @param startStruct struct that should belong to found cycles.
-     * @param visitedTypes is used to avoid endless cycle of function calls in
-     *                     the case of cyclic types.
-     * @return true if the struct belongs to one or more cycles that
-     *         contain startStruct.
-     */
-    bool findAllCycles(
-        const std::shared_ptr<const Struct> &startStruct, CycleNode &cycleNode,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    void collectReferencedStructs(
+        std::vector<std::shared_ptr<const Struct>> &structs,
+        std::vector<const Type *> &visitedTypes) const override;
 
     std::string
     getConstructorHelper(const LocationManager &locationManager) const;
@@ -48,7 +49,8 @@ class Struct : public Record {
     /** type size is needed if number of fields is bigger than 22 */
     uint64_t typeSize;
     bool isPacked;
-    /** true if at least one field is bit field */
+    /** true if at least one field is bit field.
+     * Such structs are represented as arrays */
     bool hasBitField;
 
     bool isRepresentedAsStruct() const;
@@ -77,6 +79,34 @@ class Struct : public Record {
     std::string generateGetterForArrayRepresentation(
         unsigned fieldIndex, const LocationManager &locationManager) const;
 
+    /**
+     * @return pointer to Byte at given offset in the struct
+     */
+    std::string getFieldPointer(uint64_t offsetInBytes) const;
+
+    /**
+     * Fields of packed structs may be unaligned, their values are copied
+     * to an aligned temporary with memcpy.
+     */
+    std::string generateUnalignedGetter(
+        unsigned fieldIndex, const LocationManager &locationManager) const;
+
+    std::string generateUnalignedSetter(
+        unsigned fieldIndex, const LocationManager &locationManager) const;
+
+    /**
+     * Getter loads the integer that contains the bit field once,
+     * then shifts and masks it.
+     */
+    std::string generateGetterForBitField(
+        unsigned fieldIndex, const LocationManager &locationManager) const;
+
+    /**
+     * Setter replaces bits of the field in the integer that contains it.
+     */
+    std::string generateSetterForBitField(
+        unsigned fieldIndex, const LocationManager &locationManager) const;
+
     /**
      * This function is used to get type replacement for a field that should
      * break Scala Native types cycle.
@@ -88,50 +118,17 @@ class Struct : public Record {
      *           CStruct0 (it may happen in function pointer types)
      */
     std::shared_ptr<const Type>
-    getTypeReplacement(std::shared_ptr<const Type> type,
-                       std::vector<std::shared_ptr<const Struct>>
-                           structTypesThatShouldBeReplaced) const;
-
-    /**
-     * Scala Native does not support cyclic types.
-     * Cycles may contain structs, typedefs, pointer types and function
-     * pointer types.
-     * Unions are represented as arrays therefore they cannot belong to cycle.
-     * Cycle cannot be broken on value type. There exist at least one field in
-     * cycle of pointer type / function pointer type (or typedef alias to one of
-     * these types) because otherwise cycle produces structs of
-     * infinite size.
-     *
-     * Type of the field may contain a pointer to a struct (or typedef
-     * alias to this type).
-     * The pointer should be replaced with a pointer to Byte in following case:
-     * - field belongs to a cycle
-     * - name of the struct is the biggest among all structs in the
-     *   cycle that also have fields of non-value type.
-     *
-     * Note: a field may belong to one or more cycles. It is not enough to check
-     *       only one of cycles.
-     *
-     * @return vector of structs that should be replaced by Byte type in order
-     *         to break cycle.
-     */
-    std::vector<std::shared_ptr<const Struct>>
-    shouldFieldBreakCycle(const std::shared_ptr<Field> &field) const;
-
-    /**
-     * @return true if current struct has the biggest name among all structs in
-     *         the cycle that also have fields of non-value type.
-     */
-    bool hasBiggestName(const CycleNode &node,
-                        std::vector<std::string> namesInCycle) const;
+    getTypeReplacement(const std::shared_ptr<const Type> &type,
+                       const std::vector<std::shared_ptr<const Struct>>
+                           &structTypesThatShouldBeReplaced) const;
 
-    bool isArrayOrRecord(std::shared_ptr<const Type> type) const;
+    bool isArrayOrRecord(const std::shared_ptr<const Type> &type) const;
 
     /**
      * @return pointer to given type if given type is record or array
      */
     std::shared_ptr<const Type>
-    wrapArrayOrRecordInPointer(std::shared_ptr<const Type> type) const;
+    wrapArrayOrRecordInPointer(const std::shared_ptr<const Type> &type) const;
 };
 
 #endif // SCALA_NATIVE_BINDGEN_STRUCT_H
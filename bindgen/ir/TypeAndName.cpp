@@ -4,12 +4,15 @@
 TypeAndName::TypeAndName(std::string name, std::shared_ptr<const Type> type)
     : name(std::move(name)), type(std::move(type)) {}
 
-std::shared_ptr<const Type> TypeAndName::getType() const { return type; }
+const std::shared_ptr<const Type> &TypeAndName::getType() const {
+    return type;
+}
 
 std::string TypeAndName::getName() const { return name; }
 
 void TypeAndName::setType(std::shared_ptr<const Type> type) {
     this->type = type;
+    Type::invalidateCachedStrs();
 }
 
 bool TypeAndName::operator==(const TypeAndName &other) const {
@@ -23,9 +26,9 @@ bool TypeAndName::operator!=(const TypeAndName &other) const {
     return !(*this == other);
 }
 
-bool TypeAndName::usesType(
-    const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool TypeAndName::usesType(const std::shared_ptr<const Type> &type,
+                           bool stopOnTypeDefs,
+                           std::vector<const Type *> &visitedTypes) const {
     if (*this->type == *type) {
         return true;
     }
@@ -13,7 +13,7 @@ class TypeAndName {
   public:
     TypeAndName(std::string name, std::shared_ptr<const Type> type);
 
-    std::shared_ptr<const Type> getType() const;
+    const std::shared_ptr<const Type> &getType() const;
 
     void setType(std::shared_ptr<const Type> name);
 
@@ -24,7 +24,7 @@ class TypeAndName {
     bool operator!=(const TypeAndName &other) const;
 
     bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-                  std::vector<std::shared_ptr<const Type>> &visitedTypes) const;
+                  std::vector<const Type *> &visitedTypes) const;
 
   protected:
     std::string name;
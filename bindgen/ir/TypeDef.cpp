@@ -2,12 +2,13 @@
 #include "../Utils.h"
 #include "Struct.h"
 #include "Union.h"
+#include "types/TypeFactory.h"
 #include <sstream>
 #include <stdexcept>
 
 TypeDef::TypeDef(std::string name, std::shared_ptr<const Type> type,
                  std::shared_ptr<Location> location)
-    : TypeAndName(std::move(name), std::move(type)),
+    : Type(Kind::TypeDef), TypeAndName(std::move(name), std::move(type)),
       LocatableType(std::move(location)) {}
 
 std::string
@@ -23,9 +24,9 @@ TypeDef::getDefinition(const LocationManager &locationManager) const {
     return s.str();
 }
 
-bool TypeDef::usesType(
-    const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool TypeDef::usesType(const std::shared_ptr<const Type> &type,
+                       bool stopOnTypeDefs,
+                       std::vector<const Type *> &visitedTypes) const {
     if (stopOnTypeDefs) {
         return false;
     }
@@ -35,7 +36,7 @@ bool TypeDef::usesType(
     if (contains(this, visitedTypes)) {
         return false;
     }
-    visitedTypes.push_back(shared_from_this());
+    visitedTypes.push_back(this);
     bool result = *this->type == *type ||
                   this->type->usesType(type, stopOnTypeDefs, visitedTypes);
     visitedTypes.pop_back();
@@ -43,21 +44,26 @@ bool TypeDef::usesType(
 }
 
 std::string TypeDef::str(const LocationManager &locationManager) const {
+    if (const std::string *cached = getCachedStr(locationManager)) {
+        return *cached;
+    }
     if (hasLocation()) {
         std::shared_ptr<const Location> location = getLocation();
         if (locationManager.isImported(*location)) {
-            return locationManager.getImportedType(*location, name);
+            return setCachedStr(
+                locationManager,
+                locationManager.getImportedType(*location, name));
         }
     }
-    return handleReservedWords(replaceChar(name, " ", "_"));
+    return setCachedStr(locationManager,
+                        handleReservedWords(replaceChar(name, " ", "_")));
 }
 
 bool TypeDef::operator==(const Type &other) const {
     if (this == &other) {
         return true;
     }
-    if (isInstanceOf<TypeDef>(&other)) {
-        auto *typDef = dynamic_cast<const TypeDef *>(&other);
+    if (auto *typDef = dyn_cast<TypeDef>(&other)) {
         if (name != typDef->name) {
             return false;
         }
@@ -77,8 +83,7 @@ std::shared_ptr<Location> TypeDef::getLocation() const {
         /* if typedef is not generated */
         return location;
     }
-    auto recordPointer = std::dynamic_pointer_cast<const Record>(type);
-    if (recordPointer) {
+    if (auto recordPointer = dyn_cast<Record>(type)) {
         return recordPointer->getLocation();
     }
     throw std::logic_error("Generated typedef may reference only records.");
@@ -86,41 +91,43 @@ std::shared_ptr<Location> TypeDef::getLocation() const {
 
 bool TypeDef::hasLocation() const { return location || type; }
 
-bool TypeDef::findAllCycles(
-    const std::shared_ptr<const Struct> &startStruct, CycleNode &cycleNode,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+void TypeDef::collectReferencedStructs(
+    std::vector<std::shared_ptr<const Struct>> &structs,
+    std::vector<const Type *> &visitedTypes) const {
     if (contains(this, visitedTypes) || !type) {
-        return false;
+        return;
     }
-    visitedTypes.push_back(shared_from_this());
-    bool result = type->findAllCycles(startStruct, cycleNode, visitedTypes);
+    visitedTypes.push_back(this);
+    type->collectReferencedStructs(structs, visitedTypes);
     visitedTypes.pop_back();
-    return result;
 }
 
-std::shared_ptr<const Type> TypeDef::unrollTypedefs() const {
+std::shared_ptr<const Type>
+TypeDef::unrollTypedefs(TypeFactory &typeFactory) const {
     if (isGenerated()) {
-        return std::make_shared<TypeDef>(name, type, nullptr);
+        return typeFactory.getArena().make<TypeDef>(name, type, nullptr);
     }
-    return type->unrollTypedefs();
+    return type->unrollTypedefs(typeFactory);
 }
 
 std::shared_ptr<const Type>
 TypeDef::replaceType(const std::shared_ptr<const Type> &type,
-                     const std::shared_ptr<const Type> &replacement) const {
+                     const std::shared_ptr<const Type> &replacement,
+                     TypeFactory &typeFactory) const {
+    Arena &arena = typeFactory.getArena();
     if (isGenerated()) {
-        return std::make_shared<TypeDef>(name, this->type, nullptr);
+        return arena.make<TypeDef>(name, this->type, nullptr);
     }
     if (*this->type == *type) {
-        return std::make_shared<TypeDef>(name, replacement, nullptr);
+        return arena.make<TypeDef>(name, replacement, nullptr);
     }
-    return std::make_shared<TypeDef>(
-        name, this->type->replaceType(type, replacement), nullptr);
+    return arena.make<TypeDef>(
+        name, this->type->replaceType(type, replacement, typeFactory),
+        nullptr);
 }
 
 bool TypeDef::wrapperForOpaqueType() const { return !type; }
 
 bool TypeDef::isGenerated() const {
-    return !this->type || isInstanceOf<Struct>(this->type.get()) ||
-           isInstanceOf<Union>(this->type.get());
+    return !this->type || isa<Record>(this->type);
 }
@@ -15,11 +15,14 @@ class TypeDef : public TypeAndName, public LocatableType {
     TypeDef(std::string name, std::shared_ptr<const Type> type,
             std::shared_ptr<Location> location);
 
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::TypeDef;
+    }
+
     std::string getDefinition(const LocationManager &locationManager) const;
 
-    bool usesType(
-        const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
+                  std::vector<const Type *> &visitedTypes) const override;
 
     std::string str(const LocationManager &locationManager) const override;
 
@@ -35,15 +38,17 @@ class TypeDef : public TypeAndName, public LocatableType {
      */
     bool wrapperForOpaqueType() const;
 
-    bool findAllCycles(
-        const std::shared_ptr<const Struct> &startStruct, CycleNode &cycleNode,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    void collectReferencedStructs(
+        std::vector<std::shared_ptr<const Struct>> &structs,
+        std::vector<const Type *> &visitedTypes) const override;
 
-    std::shared_ptr<const Type> unrollTypedefs() const override;
+    std::shared_ptr<const Type>
+    unrollTypedefs(TypeFactory &typeFactory) const override;
 
     std::shared_ptr<const Type>
     replaceType(const std::shared_ptr<const Type> &type,
-                const std::shared_ptr<const Type> &replacement) const override;
+                const std::shared_ptr<const Type> &replacement,
+                TypeFactory &typeFactory) const override;
 
     /**
      * @return location of the typedef is it is not generated otherwise
@@ -5,16 +5,19 @@
 #include "types/FunctionPointerType.h"
 #include "types/PointerType.h"
 #include "types/PrimitiveType.h"
+#include "types/TypeFactory.h"
 #include <sstream>
 
 Union::Union(std::string name, std::vector<std::shared_ptr<Field>> fields,
-             uint64_t maxSize, std::shared_ptr<Location> location)
-    : Record(std::move(name), std::move(fields), std::move(location)),
-      ArrayType(std::make_shared<PrimitiveType>("Byte"), maxSize) {}
+             uint64_t maxSize, std::shared_ptr<Location> location,
+             TypeFactory &typeFactory)
+    : Type(Kind::Union), Record(std::move(name), std::move(fields),
+                                std::move(location), typeFactory),
+      ArrayType(typeFactory.getPrimitiveType("Byte"), maxSize) {}
 
 std::shared_ptr<TypeDef> Union::generateTypeDef() {
-    return std::make_shared<TypeDef>(getTypeName(), shared_from_this(),
-                                     nullptr);
+    return typeFactory.getArena().make<TypeDef>(getTypeName(),
+                                                shared_from_this(), nullptr);
 }
 
 std::string
@@ -40,22 +43,21 @@ bool Union::operator==(const Type &other) const {
     if (this == &other) {
         return true;
     }
-    auto *u = dynamic_cast<const Union *>(&other);
-    if (u) {
+    if (auto *u = dyn_cast<Union>(&other)) {
         /* unions have unique names */
         return name == u->name;
     }
     return false;
 }
 
-bool Union::usesType(
-    const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool Union::usesType(const std::shared_ptr<const Type> &type,
+                     bool stopOnTypeDefs,
+                     std::vector<const Type *> &visitedTypes) const {
 
     if (contains(this, visitedTypes)) {
         return false;
     }
-    visitedTypes.push_back(shared_from_this());
+    visitedTypes.push_back(this);
 
     if (ArrayType::usesType(type, stopOnTypeDefs, visitedTypes)) {
         visitedTypes.pop_back();
@@ -66,6 +68,13 @@ bool Union::usesType(
     return Record::usesType(type, stopOnTypeDefs, visitedTypes);
 }
 
+void Union::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes,
+    std::vector<const Type *> &visitedTypes) const {
+    ArrayType::collectUsedTypes(usedTypes, visitedTypes);
+    Record::collectUsedTypes(usedTypes, visitedTypes);
+}
+
 std::string
 Union::generateGetter(const std::shared_ptr<Field> &field,
                       const LocationManager &locationManager) const {
@@ -12,7 +12,12 @@
 class Union : public Record, public ArrayType {
   public:
     Union(std::string name, std::vector<std::shared_ptr<Field>> fields,
-          uint64_t maxSize, std::shared_ptr<Location> location);
+          uint64_t maxSize, std::shared_ptr<Location> location,
+          TypeFactory &typeFactory);
+
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::Union;
+    }
 
     std::shared_ptr<TypeDef> generateTypeDef() override;
 
@@ -23,9 +28,12 @@ class Union : public Record, public ArrayType {
 
     std::string getTypeName() const override;
 
-    bool usesType(
-        const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
+                  std::vector<const Type *> &visitedTypes) const override;
+
+    void collectUsedTypes(
+        std::vector<std::shared_ptr<const Type>> &usedTypes,
+        std::vector<const Type *> &visitedTypes) const override;
 
   private:
     std::string generateGetter(const std::shared_ptr<Field> &field,
@@ -13,3 +13,10 @@ Variable::getDefinition(const LocationManager &locationManager) const {
 bool Variable::hasIllegalUsageOfOpaqueType() const {
     return isAliasForOpaqueType(type.get());
 }
+
+void Variable::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes) const {
+    std::vector<const Type *> visitedTypes;
+    usedTypes.push_back(type);
+    type->collectUsedTypes(usedTypes, visitedTypes);
+}
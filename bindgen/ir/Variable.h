@@ -11,6 +11,13 @@ class Variable : public TypeAndName {
     std::string getDefinition(const LocationManager &locationManager) const;
 
     bool hasIllegalUsageOfOpaqueType() const;
+
+    /**
+     * Add types that are used by the variable to usedTypes.
+     * @see Type::collectUsedTypes
+     */
+    void
+    collectUsedTypes(std::vector<std::shared_ptr<const Type>> &usedTypes) const;
 };
 
 #endif // SCALA_NATIVE_BINDGEN_VARIABLE_H
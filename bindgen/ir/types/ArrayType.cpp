@@ -1,34 +1,52 @@
 #include "ArrayType.h"
 #include "../../Utils.h"
-#include "../Union.h"
+#include "TypeFactory.h"
 
 ArrayType::ArrayType(std::shared_ptr<const Type> elementsType, uint64_t size)
-    : size(size), elementsType(std::move(elementsType)) {}
+    : Type(Kind::Array), size(size), elementsType(std::move(elementsType)) {}
 
 std::string ArrayType::str(const LocationManager &locationManager) const {
-    return "native.CArray[" + elementsType->str(locationManager) + ", " +
-           uint64ToScalaNat(size) + "]";
+    if (const std::string *cached = getCachedStr(locationManager)) {
+        return *cached;
+    }
+    return setCachedStr(locationManager,
+                        "native.CArray[" + elementsType->str(locationManager) +
+                            ", " + uint64ToScalaNat(size) + "]");
 }
 
-bool ArrayType::usesType(
-    const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool ArrayType::usesType(const std::shared_ptr<const Type> &type,
+                         bool stopOnTypeDefs,
+                         std::vector<const Type *> &visitedTypes) const {
     if (contains(this, visitedTypes)) {
         return false;
     }
-    visitedTypes.push_back(shared_from_this());
+    visitedTypes.push_back(this);
     bool result = *elementsType == *type ||
                   elementsType->usesType(type, stopOnTypeDefs, visitedTypes);
     visitedTypes.pop_back();
     return result;
 }
 
+void ArrayType::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes,
+    std::vector<const Type *> &visitedTypes) const {
+    if (contains(this, visitedTypes)) {
+        return;
+    }
+    visitedTypes.push_back(this);
+    usedTypes.push_back(elementsType);
+    elementsType->collectUsedTypes(usedTypes, visitedTypes);
+    visitedTypes.pop_back();
+}
+
 bool ArrayType::operator==(const Type &other) const {
     if (this == &other) {
         return true;
     }
-    if (isInstanceOf<ArrayType>(&other) && !isInstanceOf<Union>(&other)) {
-        auto *arrayType = dynamic_cast<const ArrayType *>(&other);
+    /* interned types with the same components are the same instance,
+     * but distinct components may still be structurally equal */
+    if (other.getKind() == Kind::Array) {
+        auto *arrayType = cast<ArrayType>(&other);
         if (size != arrayType->size) {
             return false;
         }
@@ -37,17 +55,20 @@ bool ArrayType::operator==(const Type &other) const {
     return false;
 }
 
-std::shared_ptr<const Type> ArrayType::unrollTypedefs() const {
-    return std::make_shared<ArrayType>(elementsType->unrollTypedefs(), size);
+std::shared_ptr<const Type>
+ArrayType::unrollTypedefs(TypeFactory &typeFactory) const {
+    return typeFactory.getArrayType(elementsType->unrollTypedefs(typeFactory),
+                                    size);
 }
 
 std::shared_ptr<const Type>
 ArrayType::replaceType(const std::shared_ptr<const Type> &type,
-                       const std::shared_ptr<const Type> &replacement) const {
+                       const std::shared_ptr<const Type> &replacement,
+                       TypeFactory &typeFactory) const {
 
     if (*elementsType == *replacement) {
-        return std::make_shared<ArrayType>(replacement, size);
+        return typeFactory.getArrayType(replacement, size);
     }
-    return std::make_shared<ArrayType>(
-        elementsType->replaceType(type, replacement), size);
+    return typeFactory.getArrayType(
+        elementsType->replaceType(type, replacement, typeFactory), size);
 }
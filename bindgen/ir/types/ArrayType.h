@@ -7,19 +7,28 @@ class ArrayType : public virtual Type {
   public:
     ArrayType(std::shared_ptr<const Type> elementsType, uint64_t size);
 
-    bool usesType(
-        const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::Array || type->getKind() == Kind::Union;
+    }
+
+    bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
+                  std::vector<const Type *> &visitedTypes) const override;
+
+    void collectUsedTypes(
+        std::vector<std::shared_ptr<const Type>> &usedTypes,
+        std::vector<const Type *> &visitedTypes) const override;
 
     std::string str(const LocationManager &locationManager) const override;
 
     bool operator==(const Type &other) const override;
 
-    std::shared_ptr<const Type> unrollTypedefs() const override;
+    std::shared_ptr<const Type>
+    unrollTypedefs(TypeFactory &typeFactory) const override;
 
     std::shared_ptr<const Type>
     replaceType(const std::shared_ptr<const Type> &type,
-                const std::shared_ptr<const Type> &replacement) const override;
+                const std::shared_ptr<const Type> &replacement,
+                TypeFactory &typeFactory) const override;
 
   private:
     const uint64_t size;
@@ -0,0 +1,90 @@
+#ifndef SCALA_NATIVE_BINDGEN_CASTING_H
+#define SCALA_NATIVE_BINDGEN_CASTING_H
+
+#include <cassert>
+#include <memory>
+#include <type_traits>
+
+/* LLVM-style RTTI for Type hierarchy.
+ *
+ * isa<T>(type) checks Type::Kind of the value using T::classof and does not
+ * need dynamic_cast.
+ *
+ * Type is a virtual base of LocatableType, ArrayType and PrimitiveType
+ * because Union is both Record and ArrayType and Enum is both PrimitiveType
+ * and LocatableType. C++ does not allow static_cast from a virtual base,
+ * therefore cast uses static_cast when the conversion does not go through
+ * a virtual base and falls back to dynamic_cast otherwise. In both cases
+ * the kind is checked first, so dyn_cast of a value with another kind is
+ * as cheap as isa. */
+
+/**
+ * Result of a cast keeps constness of the argument.
+ */
+template <typename To, typename From>
+using CastResult =
+    typename std::conditional<std::is_const<From>::value, const To, To>::type;
+
+template <typename To, typename From, typename Enable = void>
+struct CastConverter {
+    static CastResult<To, From> *doCast(From *value) {
+        return dynamic_cast<CastResult<To, From> *>(value);
+    }
+};
+
+template <typename To, typename From>
+struct CastConverter<To, From,
+                     decltype(static_cast<CastResult<To, From> *>(
+                                  std::declval<From *>()),
+                              void())> {
+    static CastResult<To, From> *doCast(From *value) {
+        return static_cast<CastResult<To, From> *>(value);
+    }
+};
+
+/**
+ * @return true if value is an instance of To
+ */
+template <typename To, typename From> inline bool isa(From *value) {
+    assert(value && "isa<> used on a null pointer");
+    return To::classof(value);
+}
+
+template <typename To, typename From>
+inline bool isa(const std::shared_ptr<From> &value) {
+    return isa<To>(value.get());
+}
+
+/**
+ * @return value converted to To. The value must be an instance of To.
+ */
+template <typename To, typename From>
+inline CastResult<To, From> *cast(From *value) {
+    assert(isa<To>(value) && "cast<> argument of incompatible type");
+    return CastConverter<To, From>::doCast(value);
+}
+
+template <typename To, typename From>
+inline std::shared_ptr<CastResult<To, From>>
+cast(const std::shared_ptr<From> &value) {
+    return std::shared_ptr<CastResult<To, From>>(value, cast<To>(value.get()));
+}
+
+/**
+ * @return value converted to To or nullptr if value is not an instance of To
+ */
+template <typename To, typename From>
+inline CastResult<To, From> *dyn_cast(From *value) {
+    return isa<To>(value) ? cast<To>(value) : nullptr;
+}
+
+template <typename To, typename From>
+inline std::shared_ptr<CastResult<To, From>>
+dyn_cast(const std::shared_ptr<From> &value) {
+    if (!isa<To>(value)) {
+        return nullptr;
+    }
+    return cast<To>(value);
+}
+
+#endif // SCALA_NATIVE_BINDGEN_CASTING_H
@@ -1,15 +1,19 @@
 #include "FunctionPointerType.h"
 #include "../../Utils.h"
+#include "TypeFactory.h"
 #include <sstream>
 
 FunctionPointerType::FunctionPointerType(
     std::shared_ptr<const Type> returnType,
     std::vector<std::shared_ptr<const Type>> &parametersTypes, bool isVariadic)
-    : returnType(std::move(returnType)), parametersTypes(parametersTypes),
-      isVariadic(isVariadic) {}
+    : Type(Kind::FunctionPointer), returnType(std::move(returnType)),
+      parametersTypes(parametersTypes), isVariadic(isVariadic) {}
 
 std::string
 FunctionPointerType::str(const LocationManager &locationManager) const {
+    if (const std::string *cached = getCachedStr(locationManager)) {
+        return *cached;
+    }
     std::stringstream ss;
     ss << "native.CFunctionPtr" << parametersTypes.size() << "[";
 
@@ -21,16 +25,16 @@ FunctionPointerType::str(const LocationManager &locationManager) const {
         ss << "native.CVararg, ";
     }
     ss << returnType->str(locationManager) << "]";
-    return ss.str();
+    return setCachedStr(locationManager, ss.str());
 }
 
 bool FunctionPointerType::usesType(
     const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+    std::vector<const Type *> &visitedTypes) const {
     if (contains(this, visitedTypes)) {
         return false;
     }
-    visitedTypes.push_back(shared_from_this());
+    visitedTypes.push_back(this);
 
     if (*returnType == *type ||
         returnType->usesType(type, stopOnTypeDefs, visitedTypes)) {
@@ -49,13 +53,29 @@ bool FunctionPointerType::usesType(
     return false;
 }
 
+void FunctionPointerType::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes,
+    std::vector<const Type *> &visitedTypes) const {
+    if (contains(this, visitedTypes)) {
+        return;
+    }
+    visitedTypes.push_back(this);
+    usedTypes.push_back(returnType);
+    returnType->collectUsedTypes(usedTypes, visitedTypes);
+    for (const auto &parameterType : parametersTypes) {
+        usedTypes.push_back(parameterType);
+        parameterType->collectUsedTypes(usedTypes, visitedTypes);
+    }
+    visitedTypes.pop_back();
+}
+
 bool FunctionPointerType::operator==(const Type &other) const {
     if (this == &other) {
         return true;
     }
-    if (isInstanceOf<const FunctionPointerType>(&other)) {
-        auto *functionPointerType =
-            dynamic_cast<const FunctionPointerType *>(&other);
+    /* interned types with the same components are the same instance,
+     * but distinct components may still be structurally equal */
+    if (auto *functionPointerType = dyn_cast<FunctionPointerType>(&other)) {
         if (isVariadic != functionPointerType->isVariadic) {
             return false;
         }
@@ -77,43 +97,36 @@ bool FunctionPointerType::operator==(const Type &other) const {
     return false;
 }
 
-bool FunctionPointerType::findAllCycles(
-    const std::shared_ptr<const Struct> &startStruct, CycleNode &cycleNode,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
-
+void FunctionPointerType::collectReferencedStructs(
+    std::vector<std::shared_ptr<const Struct>> &structs,
+    std::vector<const Type *> &visitedTypes) const {
     if (contains(this, visitedTypes)) {
-        return false;
+        return;
     }
-    visitedTypes.push_back(shared_from_this());
-
-    bool foundCycle = false;
-
-    if (returnType->findAllCycles(startStruct, cycleNode, visitedTypes)) {
-        foundCycle = true;
-    }
-
+    visitedTypes.push_back(this);
+    returnType->collectReferencedStructs(structs, visitedTypes);
     for (const auto &parameterType : parametersTypes) {
-        if (parameterType->findAllCycles(startStruct, cycleNode,
-                                         visitedTypes)) {
-            foundCycle = true;
-        }
+        parameterType->collectReferencedStructs(structs, visitedTypes);
     }
     visitedTypes.pop_back();
-    return foundCycle;
 }
 
-std::shared_ptr<const Type> FunctionPointerType::unrollTypedefs() const {
+std::shared_ptr<const Type>
+FunctionPointerType::unrollTypedefs(TypeFactory &typeFactory) const {
     std::vector<std::shared_ptr<const Type>> unrolledParameterTypes;
     for (const auto &parameterType : parametersTypes) {
-        unrolledParameterTypes.push_back(parameterType->unrollTypedefs());
+        unrolledParameterTypes.push_back(
+            parameterType->unrollTypedefs(typeFactory));
     }
-    return std::make_shared<FunctionPointerType>(
-        returnType->unrollTypedefs(), unrolledParameterTypes, isVariadic);
+    return typeFactory.getFunctionPointerType(
+        returnType->unrollTypedefs(typeFactory), unrolledParameterTypes,
+        isVariadic);
 }
 
 std::shared_ptr<const Type> FunctionPointerType::replaceType(
     const std::shared_ptr<const Type> &type,
-    const std::shared_ptr<const Type> &replacement) const {
+    const std::shared_ptr<const Type> &replacement,
+    TypeFactory &typeFactory) const {
     std::shared_ptr<const Type> newReturnType = returnType;
     if (*returnType == *type) {
         newReturnType = replacement;
@@ -127,6 +140,6 @@ std::shared_ptr<const Type> FunctionPointerType::replaceType(
         }
     }
 
-    return std::make_shared<FunctionPointerType>(
-        newReturnType, newParametersTypes, isVariadic);
+    return typeFactory.getFunctionPointerType(newReturnType,
+                                              newParametersTypes, isVariadic);
 }
@@ -1,60 +1,78 @@
 #include "PointerType.h"
 #include "../../Utils.h"
+#include "TypeFactory.h"
 
 PointerType::PointerType(std::shared_ptr<const Type> type)
-    : type(std::move(type)) {}
+    : Type(Kind::Pointer), type(std::move(type)) {}
 
 std::string PointerType::str(const LocationManager &locationManager) const {
-    return "native.Ptr[" + type->str(locationManager) + "]";
+    if (const std::string *cached = getCachedStr(locationManager)) {
+        return *cached;
+    }
+    return setCachedStr(locationManager,
+                        "native.Ptr[" + type->str(locationManager) + "]");
 }
 
-bool PointerType::usesType(
-    const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool PointerType::usesType(const std::shared_ptr<const Type> &type,
+                           bool stopOnTypeDefs,
+                           std::vector<const Type *> &visitedTypes) const {
     if (contains(this, visitedTypes)) {
         return false;
     }
-    visitedTypes.push_back(shared_from_this());
+    visitedTypes.push_back(this);
     bool result = *this->type == *type ||
                   this->type->usesType(type, stopOnTypeDefs, visitedTypes);
     visitedTypes.pop_back();
     return result;
 }
 
+void PointerType::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes,
+    std::vector<const Type *> &visitedTypes) const {
+    if (contains(this, visitedTypes)) {
+        return;
+    }
+    visitedTypes.push_back(this);
+    usedTypes.push_back(type);
+    type->collectUsedTypes(usedTypes, visitedTypes);
+    visitedTypes.pop_back();
+}
+
 bool PointerType::operator==(const Type &other) const {
     if (this == &other) {
         return true;
     }
-    if (isInstanceOf<PointerType>(&other)) {
-        auto *pointerType = dynamic_cast<const PointerType *>(&other);
+    /* interned types with the same components are the same instance,
+     * but distinct components may still be structurally equal */
+    if (auto *pointerType = dyn_cast<PointerType>(&other)) {
         return *type == *pointerType->type;
     }
     return false;
 }
 
-bool PointerType::findAllCycles(
-    const std::shared_ptr<const Struct> &startStruct, CycleNode &cycleNode,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+void PointerType::collectReferencedStructs(
+    std::vector<std::shared_ptr<const Struct>> &structs,
+    std::vector<const Type *> &visitedTypes) const {
     if (contains(this, visitedTypes)) {
-        return false;
+        return;
     }
-    visitedTypes.push_back(shared_from_this());
-    bool result =
-        this->type->findAllCycles(startStruct, cycleNode, visitedTypes);
+    visitedTypes.push_back(this);
+    type->collectReferencedStructs(structs, visitedTypes);
     visitedTypes.pop_back();
-    return result;
 }
 
-std::shared_ptr<const Type> PointerType::unrollTypedefs() const {
-    return std::make_shared<PointerType>(type->unrollTypedefs());
+std::shared_ptr<const Type>
+PointerType::unrollTypedefs(TypeFactory &typeFactory) const {
+    return typeFactory.getPointerType(type->unrollTypedefs(typeFactory));
 }
 
 std::shared_ptr<const Type>
 PointerType::replaceType(const std::shared_ptr<const Type> &type,
-                         const std::shared_ptr<const Type> &replacement) const {
+                         const std::shared_ptr<const Type> &replacement,
+                         TypeFactory &typeFactory) const {
     if (*this->type == *type) {
-        return std::make_shared<PointerType>(replacement);
+        return typeFactory.getPointerType(replacement);
     }
-    return std::make_shared<PointerType>(
-        this->type->replaceType(type, replacement));
+    return typeFactory.getPointerType(
+        this->type->replaceType(type, replacement, typeFactory));
 }
@@ -7,23 +7,32 @@ class PointerType : public Type {
   public:
     explicit PointerType(std::shared_ptr<const Type> type);
 
-    bool usesType(
-        const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::Pointer;
+    }
 
-    bool findAllCycles(
-        const std::shared_ptr<const Struct> &startStruct, CycleNode &cycleNode,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
+                  std::vector<const Type *> &visitedTypes) const override;
+
+    void collectUsedTypes(
+        std::vector<std::shared_ptr<const Type>> &usedTypes,
+        std::vector<const Type *> &visitedTypes) const override;
+
+    void collectReferencedStructs(
+        std::vector<std::shared_ptr<const Struct>> &structs,
+        std::vector<const Type *> &visitedTypes) const override;
 
     std::string str(const LocationManager &locationManager) const override;
 
     bool operator==(const Type &other) const override;
 
-    std::shared_ptr<const Type> unrollTypedefs() const override;
+    std::shared_ptr<const Type>
+    unrollTypedefs(TypeFactory &typeFactory) const override;
 
     std::shared_ptr<const Type>
     replaceType(const std::shared_ptr<const Type> &type,
-                const std::shared_ptr<const Type> &replacement) const override;
+                const std::shared_ptr<const Type> &replacement,
+                TypeFactory &typeFactory) const override;
 
   private:
     std::shared_ptr<const Type> type;
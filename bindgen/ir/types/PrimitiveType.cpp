@@ -1,8 +1,9 @@
 #include "PrimitiveType.h"
 #include "../../Utils.h"
-#include "../Enum.h"
+#include "TypeFactory.h"
 
-PrimitiveType::PrimitiveType(std::string type) : type(std::move(type)) {}
+PrimitiveType::PrimitiveType(std::string type)
+    : Type(Kind::Primitive), type(std::move(type)) {}
 
 std::string PrimitiveType::str() const { return handleReservedWords(type); }
 
@@ -12,9 +13,9 @@ std::string PrimitiveType::str(const LocationManager &locationManager) const {
 
 std::string PrimitiveType::getType() const { return type; }
 
-bool PrimitiveType::usesType(
-    const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
+bool PrimitiveType::usesType(const std::shared_ptr<const Type> &type,
+                             bool stopOnTypeDefs,
+                             std::vector<const Type *> &visitedTypes) const {
     return false;
 }
 
@@ -22,19 +23,24 @@ bool PrimitiveType::operator==(const Type &other) const {
     if (this == &other) {
         return true;
     }
-    if (isInstanceOf<PrimitiveType>(&other) && !isInstanceOf<Enum>(&other)) {
-        auto *primitiveType = dynamic_cast<const PrimitiveType *>(&other);
-        return type == primitiveType->type;
+    if (isInterned() && other.isInterned()) {
+        /* interned types are unique */
+        return false;
+    }
+    if (other.getKind() == Kind::Primitive) {
+        return type == cast<PrimitiveType>(&other)->type;
     }
     return false;
 }
 
-std::shared_ptr<const Type> PrimitiveType::unrollTypedefs() const {
-    return std::make_shared<PrimitiveType>(type);
+std::shared_ptr<const Type>
+PrimitiveType::unrollTypedefs(TypeFactory &typeFactory) const {
+    return typeFactory.getPrimitiveType(type);
 }
 
 std::shared_ptr<const Type> PrimitiveType::replaceType(
     const std::shared_ptr<const Type> &type,
-    const std::shared_ptr<const Type> &replacement) const {
+    const std::shared_ptr<const Type> &replacement,
+    TypeFactory &typeFactory) const {
     return shared_from_this();
 }
@@ -11,11 +11,15 @@ class PrimitiveType : virtual public Type {
   public:
     explicit PrimitiveType(std::string type);
 
+    static bool classof(const Type *type) {
+        return type->getKind() == Kind::Primitive ||
+               type->getKind() == Kind::Enum;
+    }
+
     std::string getType() const;
 
-    bool usesType(
-        const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-        std::vector<std::shared_ptr<const Type>> &visitedTypes) const override;
+    bool usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
+                  std::vector<const Type *> &visitedTypes) const override;
 
     std::string str() const;
 
@@ -23,11 +27,13 @@ class PrimitiveType : virtual public Type {
 
     bool operator==(const Type &other) const override;
 
-    std::shared_ptr<const Type> unrollTypedefs() const override;
+    std::shared_ptr<const Type>
+    unrollTypedefs(TypeFactory &typeFactory) const override;
 
     std::shared_ptr<const Type>
     replaceType(const std::shared_ptr<const Type> &type,
-                const std::shared_ptr<const Type> &replacement) const override;
+                const std::shared_ptr<const Type> &replacement,
+                TypeFactory &typeFactory) const override;
 
   private:
     std::string type;
@@ -1,22 +1,52 @@
 #include "Type.h"
 #include <cassert>
 
-CycleNode::CycleNode(std::shared_ptr<const Struct> s, const Field *field)
-    : s(std::move(s)), field(field) {}
+thread_local uint64_t Type::typesVersion = 1;
+
+Type::Type(Kind kind) : kind(kind) {}
+
+void Type::collectUsedTypes(
+    std::vector<std::shared_ptr<const Type>> &usedTypes,
+    std::vector<const Type *> &visitedTypes) const {}
 
 bool Type::operator!=(const Type &other) const { return !(*this == other); }
 
-bool Type::findAllCycles(
-    const std::shared_ptr<const Struct> &startStruct, CycleNode &cycleNode,
-    std::vector<std::shared_ptr<const Type>> &visitedTypes) const {
-    return false;
+bool Type::isInterned() const { return interned; }
+
+void Type::invalidateCachedStrs() { typesVersion++; }
+
+const std::string *
+Type::getCachedStr(const LocationManager &locationManager) const {
+    if (cachedStrLocationManager != &locationManager ||
+        cachedStrVersion != typesVersion) {
+        return nullptr;
+    }
+    return &cachedStr;
+}
+
+const std::string &Type::setCachedStr(const LocationManager &locationManager,
+                                      std::string str) const {
+    cachedStr = std::move(str);
+    cachedStrLocationManager = &locationManager;
+    cachedStrVersion = typesVersion;
+    return cachedStr;
 }
 
-std::shared_ptr<const Type> Type::unrollTypedefs() const { return nullptr; }
+void Type::setInterned() { interned = true; }
+
+void Type::collectReferencedStructs(
+    std::vector<std::shared_ptr<const Struct>> &structs,
+    std::vector<const Type *> &visitedTypes) const {}
+
+std::shared_ptr<const Type>
+Type::unrollTypedefs(TypeFactory &typeFactory) const {
+    return nullptr;
+}
 
 std::shared_ptr<const Type>
 Type::replaceType(const std::shared_ptr<const Type> &type,
-                  const std::shared_ptr<const Type> &replacement) const {
+                  const std::shared_ptr<const Type> &replacement,
+                  TypeFactory &typeFactory) const {
     assert(
         false &&
         "Base class implementation of replaceType method must not be executed");
@@ -2,28 +2,47 @@
 #define SCALA_NATIVE_BINDGEN_TYPE_H
 
 #include "../LocationManager.h"
+#include "Casting.h"
 #include <memory>
 #include <string>
 #include <vector>
 
 class Struct;
-class Field;
-
-struct CycleNode {
-    CycleNode(std::shared_ptr<const Struct> s, const Field *field);
-    std::shared_ptr<const Struct> s;
-    const Field *field;
-    std::vector<CycleNode> cycleNodes;
-    bool isValueType = false;
-};
+class TypeFactory;
 
 /**
  * Base class for types.
  */
 class Type : public std::enable_shared_from_this<Type> {
   public:
+    /**
+     * Most derived class of the type.
+     * Used by classof methods, see Casting.h
+     */
+    enum class Kind {
+        Primitive,
+        Enum,
+        Pointer,
+        FunctionPointer,
+        Array,
+        Union,
+        Struct,
+        TypeDef
+    };
+
+    /**
+     * Type is a virtual base of some classes therefore it is initialized
+     * by the most derived class.
+     */
+    explicit Type(Kind kind);
+
     virtual ~Type() = default;
 
+    Kind getKind() const { return kind; }
+
+    /**
+     * Implementations may cache the result, see getCachedStr.
+     */
     virtual std::string str(const LocationManager &locationManager) const = 0;
 
     /**
@@ -36,55 +55,109 @@ class Type : public std::enable_shared_from_this<Type> {
      *
      * @return true if type uses search type.
      */
-    virtual bool
-    usesType(const std::shared_ptr<const Type> &type, bool stopOnTypeDefs,
-             std::vector<std::shared_ptr<const Type>> &visitedTypes) const = 0;
+    virtual bool usesType(const std::shared_ptr<const Type> &type,
+                          bool stopOnTypeDefs,
+                          std::vector<const Type *> &visitedTypes) const = 0;
+
+    /**
+     * Add types that current type consists of to usedTypes.
+     * Found types are the same types for which usesType returns true
+     * if stopOnTypeDefs is true.
+     * @param visitedTypes is used to avoid endless cycle of function calls in
+     *                     the case of cyclic types.
+     */
+    virtual void collectUsedTypes(
+        std::vector<std::shared_ptr<const Type>> &usedTypes,
+        std::vector<const Type *> &visitedTypes) const;
 
     virtual bool operator==(const Type &other) const = 0;
 
     virtual bool operator!=(const Type &other) const;
 
     /**
-     * @param startStruct struct that should belong to found
-     *                    cycles.
+     * Invalidate strings cached by str methods.
+     * Must be called when a type is changed after it was created,
+     * for example when a typedef gets new underlying type.
+     */
+    static void invalidateCachedStrs();
+
+    /**
+     * @return true if the type was created by TypeFactory.
+     *         Interned primitive types are equal only if they are the same
+     *         instance.
+     */
+    bool isInterned() const;
+
+    /**
+     * Add structs that current type references to structs.
+     * Search goes through typedefs, pointers and function pointers and stops
+     * on structs, therefore found structs may form cycles of types with
+     * the struct that contains current type.
      * @param visitedTypes is used to avoid endless cycle of function calls in
      *                     the case of cyclic types.
-     * @return true if current type belongs to one or more cycles that contain
-     *         startStruct. If current type is struct or union then
-     *         cycleNode is updated (see Record::findAllCycles)
      */
-    virtual bool
-    findAllCycles(const std::shared_ptr<const Struct> &startStruct,
-                  CycleNode &cycleNode,
-                  std::vector<std::shared_ptr<const Type>> &visitedTypes) const;
+    virtual void collectReferencedStructs(
+        std::vector<std::shared_ptr<const Struct>> &structs,
+        std::vector<const Type *> &visitedTypes) const;
 
     /**
      * Execution stops at typedefs of structs and unions therefore it cannot
      * stuck in infinite recursion.
+     * @param typeFactory factory that creates types of the copy
      * @return copy of current type in which all typedefs are omitted except
      *         typedefs that wrap structs, unions, enums and opaque types.
      */
-    virtual std::shared_ptr<const Type> unrollTypedefs() const;
+    virtual std::shared_ptr<const Type>
+    unrollTypedefs(TypeFactory &typeFactory) const;
 
     /**
      * Execution stops at typedefs of structs and unions therefore it cannot
      * stuck in infinite recursion.
+     * @param typeFactory factory that creates types of the copy
      * @return copy of current type in which given type is replaced with
      *         replacement type.
      */
     virtual std::shared_ptr<const Type>
     replaceType(const std::shared_ptr<const Type> &type,
-                const std::shared_ptr<const Type> &replacement) const;
+                const std::shared_ptr<const Type> &replacement,
+                TypeFactory &typeFactory) const;
 
   protected:
+    /**
+     * @return string saved by setCachedStr for the same LocationManager or
+     *         nullptr if it was not saved or types were changed since then.
+     */
+    const std::string *
+    getCachedStr(const LocationManager &locationManager) const;
+
+    /**
+     * Save string that is returned by str method.
+     * @return saved string
+     */
+    const std::string &setCachedStr(const LocationManager &locationManager,
+                                    std::string str) const;
+
     template <typename Derived> std::shared_ptr<Derived> shared_from_base() {
-        return std::dynamic_pointer_cast<Derived>(shared_from_this());
+        return cast<Derived>(shared_from_this());
     }
 
     template <typename Derived>
     std::shared_ptr<const Derived> shared_from_base() const {
-        return std::dynamic_pointer_cast<const Derived>(shared_from_this());
+        return cast<Derived>(shared_from_this());
     }
+
+  private:
+    friend class TypeFactory;
+
+    void setInterned();
+
+    const Kind kind;
+    bool interned = false;
+    mutable std::string cachedStr;
+    mutable const LocationManager *cachedStrLocationManager = nullptr;
+    mutable uint64_t cachedStrVersion = 0;
+    /* IR of a header is built and printed by one thread */
+    static thread_local uint64_t typesVersion;
 };
 
 #endif // SCALA_NATIVE_BINDGEN_TYPE_H
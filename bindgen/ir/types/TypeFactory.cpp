@@ -0,0 +1,64 @@
+#include "TypeFactory.h"
+
+TypeFactory::TypeFactory(Arena &arena) : arena(arena) {}
+
+Arena &TypeFactory::getArena() { return arena; }
+
+std::shared_ptr<PrimitiveType>
+TypeFactory::getPrimitiveType(const std::string &type) {
+    auto it = primitiveTypes.find(type);
+    if (it != primitiveTypes.end()) {
+        return it->second;
+    }
+    auto primitiveType = arena.make<PrimitiveType>(type);
+    primitiveType->setInterned();
+    primitiveTypes.emplace(type, primitiveType);
+    return primitiveType;
+}
+
+std::shared_ptr<PointerType>
+TypeFactory::getPointerType(const std::shared_ptr<const Type> &type) {
+    auto it = pointerTypes.find(type.get());
+    if (it != pointerTypes.end()) {
+        return it->second;
+    }
+    auto pointerType = arena.make<PointerType>(type);
+    pointerType->setInterned();
+    pointerTypes.emplace(type.get(), pointerType);
+    return pointerType;
+}
+
+std::shared_ptr<ArrayType>
+TypeFactory::getArrayType(const std::shared_ptr<const Type> &elementsType,
+                          uint64_t size) {
+    auto key = std::make_pair(elementsType.get(), size);
+    auto it = arrayTypes.find(key);
+    if (it != arrayTypes.end()) {
+        return it->second;
+    }
+    auto arrayType = arena.make<ArrayType>(elementsType, size);
+    arrayType->setInterned();
+    arrayTypes.emplace(key, arrayType);
+    return arrayType;
+}
+
+std::shared_ptr<FunctionPointerType> TypeFactory::getFunctionPointerType(
+    const std::shared_ptr<const Type> &returnType,
+    std::vector<std::shared_ptr<const Type>> &parametersTypes,
+    bool isVariadic) {
+    std::vector<const Type *> parameters;
+    for (const auto &parameterType : parametersTypes) {
+        parameters.push_back(parameterType.get());
+    }
+    auto key = std::make_tuple(returnType.get(), std::move(parameters),
+                               isVariadic);
+    auto it = functionPointerTypes.find(key);
+    if (it != functionPointerTypes.end()) {
+        return it->second;
+    }
+    auto functionPointerType = arena.make<FunctionPointerType>(
+        returnType, parametersTypes, isVariadic);
+    functionPointerType->setInterned();
+    functionPointerTypes.emplace(std::move(key), functionPointerType);
+    return functionPointerType;
+}
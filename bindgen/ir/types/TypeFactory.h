@@ -0,0 +1,61 @@
+#ifndef SCALA_NATIVE_BINDGEN_TYPEFACTORY_H
+#define SCALA_NATIVE_BINDGEN_TYPEFACTORY_H
+
+#include "../Arena.h"
+#include "ArrayType.h"
+#include "FunctionPointerType.h"
+#include "PointerType.h"
+#include "PrimitiveType.h"
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+/**
+ * Creates primitive, pointer, array and function pointer types.
+ *
+ * Types with the same component instances share one instance.
+ * Component types are compared by pointer, so structurally equal types
+ * with distinct components (for example copies of a TypeDef) are different
+ * instances and Type::operator== compares them structurally.
+ */
+class TypeFactory {
+  public:
+    /**
+     * @param arena arena in which types are allocated
+     */
+    explicit TypeFactory(Arena &arena);
+
+    std::shared_ptr<PrimitiveType> getPrimitiveType(const std::string &type);
+
+    std::shared_ptr<PointerType>
+    getPointerType(const std::shared_ptr<const Type> &type);
+
+    std::shared_ptr<ArrayType>
+    getArrayType(const std::shared_ptr<const Type> &elementsType,
+                 uint64_t size);
+
+    std::shared_ptr<FunctionPointerType> getFunctionPointerType(
+        const std::shared_ptr<const Type> &returnType,
+        std::vector<std::shared_ptr<const Type>> &parametersTypes,
+        bool isVariadic);
+
+    /**
+     * @return arena of the factory, it is used for types that are not
+     *         interned
+     */
+    Arena &getArena();
+
+  private:
+    Arena &arena;
+    std::unordered_map<std::string, std::shared_ptr<PrimitiveType>>
+        primitiveTypes;
+    std::unordered_map<const Type *, std::shared_ptr<PointerType>>
+        pointerTypes;
+    std::map<std::pair<const Type *, uint64_t>, std::shared_ptr<ArrayType>>
+        arrayTypes;
+    std::map<std::tuple<const Type *, std::vector<const Type *>, bool>,
+             std::shared_ptr<FunctionPointerType>>
+        functionPointerTypes;
+};
+
+#endif // SCALA_NATIVE_BINDGEN_TYPEFACTORY_H
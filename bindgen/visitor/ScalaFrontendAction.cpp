@@ -1,9 +1,36 @@
 #include "ScalaFrontendAction.h"
+#include "../defines/DefineEvaluator.h"
+#include "../defines/DefineFinder.h"
+#include <clang/Frontend/MultiplexConsumer.h>
 
-ScalaFrontendAction::ScalaFrontendAction(IR &ir) : ir(ir) {}
+ScalaFrontendAction::ScalaFrontendAction(
+    IR &ir, bool lazyTypes, bool generateShims,
+    std::shared_ptr<clang::DependencyCollector> dependencyCollector)
+    : ir(ir), lazyTypes(lazyTypes), generateShims(generateShims),
+      dependencyCollector(std::move(dependencyCollector)) {}
 
 std::unique_ptr<clang::ASTConsumer>
 ScalaFrontendAction::CreateASTConsumer(clang::CompilerInstance &CI,
                                        clang::StringRef file) {
-    return std::unique_ptr<clang::ASTConsumer>(new TreeConsumer(&CI, ir));
+    /* bindings are generated only for declarations therefore parser may
+     * skip bodies of inline functions */
+    CI.getFrontendOpts().SkipFunctionBodies = true;
+
+    /* macros are collected during the same preprocessor run that
+     * produces declarations for TreeConsumer */
+    CI.getPreprocessor().addPPCallbacks(std::unique_ptr<clang::PPCallbacks>(
+        new DefineFinder(ir, CI, CI.getPreprocessor())));
+
+    if (dependencyCollector) {
+        dependencyCollector->attachToPreprocessor(CI.getPreprocessor());
+    }
+
+    /* macros with constant expressions are evaluated by the same
+     * compiler instance after all declarations are known */
+    std::vector<std::unique_ptr<clang::ASTConsumer>> consumers;
+    consumers.emplace_back(
+        new TreeConsumer(&CI, ir, lazyTypes, generateShims));
+    consumers.push_back(DefineEvaluator(ir).attach(CI));
+    return std::unique_ptr<clang::ASTConsumer>(
+        new clang::MultiplexConsumer(std::move(consumers)));
 }
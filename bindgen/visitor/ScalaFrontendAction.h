@@ -5,14 +5,29 @@
 
 #include "../ir/IR.h"
 #include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/Utils.h>
 
 /**
  * Creates ASTConsumer which will go through all top-level
  * declarations and execute visitor on some of them.
+ *
+ * DefineFinder and DefineEvaluator are registered on the preprocessor of
+ * the same compiler instance, so a single clang invocation collects
+ * macros, their values and declarations.
  */
 class ScalaFrontendAction : public clang::ASTFrontendAction {
   public:
-    ScalaFrontendAction(IR &ir);
+    /**
+     * @param lazyTypes if true then types from included headers are
+     *                  translated only when they are used
+     * @param generateShims if true then C wrappers are created for
+     *                      functions that do not have linkable symbol
+     * @param dependencyCollector if not nullptr then it is attached to the
+     *                            preprocessor
+     */
+    ScalaFrontendAction(IR &ir, bool lazyTypes, bool generateShims,
+                        std::shared_ptr<clang::DependencyCollector>
+                            dependencyCollector = nullptr);
 
     std::unique_ptr<clang::ASTConsumer>
     CreateASTConsumer(clang::CompilerInstance &CI,
@@ -20,6 +35,9 @@ class ScalaFrontendAction : public clang::ASTFrontendAction {
 
   private:
     IR &ir;
+    bool lazyTypes;
+    bool generateShims;
+    std::shared_ptr<clang::DependencyCollector> dependencyCollector;
 };
 
 #endif // SCALA_NATIVE_BINDGEN_SCALAFRONTENDACTION_H
@@ -1,8 +1,13 @@
 #include "ScalaFrontendActionFactory.h"
 #include "ScalaFrontendAction.h"
 
-ScalaFrontendActionFactory::ScalaFrontendActionFactory(IR &ir) : ir(ir) {}
+ScalaFrontendActionFactory::ScalaFrontendActionFactory(
+    IR &ir, bool lazyTypes, bool generateShims,
+    std::shared_ptr<clang::DependencyCollector> dependencyCollector)
+    : ir(ir), lazyTypes(lazyTypes), generateShims(generateShims),
+      dependencyCollector(std::move(dependencyCollector)) {}
 
 clang::FrontendAction *ScalaFrontendActionFactory::create() {
-    return new ScalaFrontendAction(ir);
+    return new ScalaFrontendAction(ir, lazyTypes, generateShims,
+                                   dependencyCollector);
 }
@@ -13,12 +13,17 @@
 class ScalaFrontendActionFactory
     : public clang::tooling::FrontendActionFactory {
   public:
-    ScalaFrontendActionFactory(IR &ir);
+    ScalaFrontendActionFactory(IR &ir, bool lazyTypes, bool generateShims,
+                               std::shared_ptr<clang::DependencyCollector>
+                                   dependencyCollector = nullptr);
 
     clang::FrontendAction *create() override;
 
   private:
     IR &ir;
+    bool lazyTypes;
+    bool generateShims;
+    std::shared_ptr<clang::DependencyCollector> dependencyCollector;
 };
 
 #endif // SCALA_NATIVE_BINDGEN_SCALAFRONTENDACTIONFACTORY_H
@@ -11,15 +11,20 @@ class TreeConsumer : public clang::ASTConsumer {
     clang::SourceManager &smanager;
 
   public:
-    TreeConsumer(clang::CompilerInstance *CI, IR &ir)
-        : visitor(CI, ir), smanager(CI->getASTContext().getSourceManager()) {}
+    TreeConsumer(clang::CompilerInstance *CI, IR &ir, bool lazyTypes,
+                 bool generateShims)
+        : visitor(CI, ir, lazyTypes, generateShims),
+          smanager(CI->getASTContext().getSourceManager()) {}
 
-    bool HandleTopLevelDecl(clang::DeclGroupRef DG) override {
-        // a DeclGroupRef may have multiple Decls, so we iterate through each
-        // one
-        for (auto D : DG) {
+    void HandleTranslationUnit(clang::ASTContext &context) override {
+        /* declarations are taken from translation unit instead of
+         * HandleTopLevelDecl because declarations that are loaded from
+         * precompiled preamble are not passed to HandleTopLevelDecl.
+         *
+         * Each declaration is traversed separately because visitor may stop
+         * traversal of a declaration */
+        for (auto *D : context.getTranslationUnitDecl()->decls()) {
             visitor.TraverseDecl(D);
         }
-        return true;
     }
 };
@@ -1,5 +1,29 @@
 #include "TreeVisitor.h"
 #include "../Utils.h"
+#include <algorithm>
+
+namespace {
+
+/**
+ * @return C declaration of a variable or a function with given type
+ */
+std::string getDeclaration(clang::QualType type, const std::string &name,
+                           const clang::PrintingPolicy &policy) {
+    std::string declaration;
+    llvm::raw_string_ostream s(declaration);
+    type.print(s, policy, name);
+    return s.str();
+}
+
+/**
+ * @return true if the value is struct or union that is passed
+ *         through a pointer by C wrapper
+ */
+bool isRecordValue(clang::QualType type) {
+    return type->isRecordType() && !type->isIncompleteType();
+}
+
+} // namespace
 
 bool TreeVisitor::VisitFunctionDecl(clang::FunctionDecl *func) {
     if (!astContext->getSourceManager().isInMainFile(func->getLocation())) {
@@ -7,6 +31,10 @@ bool TreeVisitor::VisitFunctionDecl(clang::FunctionDecl *func) {
         return true;
     }
     std::string funcName = func->getNameInfo().getName().getAsString();
+    /* variadic arguments cannot be passed to another function */
+    bool hasShim = generateShims && !func->isVariadic() &&
+                   (hasNoLinkableSymbol(func) || passesRecordByValue(func));
+    TypeFactory &typeFactory = ir.getTypeFactory();
     std::shared_ptr<Type> retType =
         typeTranslator.translate(func->getReturnType());
     std::vector<std::shared_ptr<Parameter>> parameters;
@@ -22,95 +50,158 @@ bool TreeVisitor::VisitFunctionDecl(clang::FunctionDecl *func) {
         }
 
         std::shared_ptr<Type> ptype = typeTranslator.translate(parm->getType());
-        parameters.emplace_back(std::make_shared<Parameter>(pname, ptype));
+        if (hasShim && isRecordValue(parm->getType())) {
+            ptype = typeFactory.getPointerType(ptype);
+        }
+        parameters.emplace_back(ir.getArena().make<Parameter>(pname, ptype));
+    }
+
+    if (hasShim && isRecordValue(func->getReturnType())) {
+        /* the wrapper writes returned value to the last parameter */
+        parameters.emplace_back(ir.getArena().make<Parameter>(
+            getResultParameterName(parameters),
+            typeFactory.getPointerType(retType)));
+        retType = typeFactory.getPrimitiveType("Unit");
     }
 
-    ir.addFunction(funcName, std::move(parameters), retType,
-                   func->isVariadic());
+    std::shared_ptr<Function> function = ir.addFunction(
+        funcName, std::move(parameters), retType, func->isVariadic());
+
+    if (hasShim) {
+        function->setShim(getShim(func, function->getShimName()));
+    }
 
     return true;
 }
 
-bool TreeVisitor::VisitTypedefDecl(clang::TypedefDecl *tpdef) {
-    std::string name = tpdef->getName();
-
-    if (isAliasForAnonymousEnum(tpdef)) {
-        /* typedef was already created */
+bool TreeVisitor::hasNoLinkableSymbol(const clang::FunctionDecl *func) const {
+    if (!func->isExternallyVisible()) {
+        /* static function */
         return true;
     }
-
-    std::shared_ptr<Type> type =
-        typeTranslator.translate(tpdef->getUnderlyingType());
-    if (type) {
-        ir.addTypeDef(name, type, typeTranslator.getLocation(tpdef));
+    bool isGnuInline = astContext->getLangOpts().GNUInline;
+    for (const clang::FunctionDecl *redecl : func->redecls()) {
+        if (redecl->hasAttr<clang::GNUInlineAttr>()) {
+            isGnuInline = true;
+        }
     }
-    return true;
+    bool isInlineDefinition = !isGnuInline;
+    for (const clang::FunctionDecl *redecl : func->redecls()) {
+        bool isExternInline = redecl->isInlineSpecified() &&
+                              redecl->getStorageClass() == clang::SC_Extern;
+        if (isGnuInline && isExternInline) {
+            /* GNU extern inline definition is used only for inlining */
+            return true;
+        }
+        if (!redecl->isInlineSpecified() ||
+            redecl->getStorageClass() == clang::SC_Extern) {
+            /* C99 inline definition is external if at least one
+             * declaration is not inline or is extern */
+            isInlineDefinition = false;
+        }
+    }
+    return isInlineDefinition;
 }
 
-bool TreeVisitor::isAliasForAnonymousEnum(clang::TypedefDecl *tpdef) const {
-    clang::QualType underlyingType = tpdef->getUnderlyingType();
-    if (!underlyingType->isEnumeralType()) {
-        return false;
+bool TreeVisitor::passesRecordByValue(const clang::FunctionDecl *func) const {
+    if (isRecordValue(func->getReturnType())) {
+        return true;
     }
-    const clang::EnumType *enumType = underlyingType->getAs<clang::EnumType>();
-    return enumType->getDecl()->getTypedefNameForAnonDecl();
+    for (const clang::ParmVarDecl *parm : func->parameters()) {
+        if (isRecordValue(parm->getType())) {
+            return true;
+        }
+    }
+    return false;
 }
 
-bool TreeVisitor::VisitEnumDecl(clang::EnumDecl *enumDecl) {
-    std::string name = enumDecl->getNameAsString();
-
-    clang::TypedefNameDecl *typedefName = enumDecl->getTypedefNameForAnonDecl();
-    if (name.empty() && typedefName) {
-        name = typedefName->getNameAsString();
+std::string TreeVisitor::getResultParameterName(
+    const std::vector<std::shared_ptr<Parameter>> &parameters) const {
+    std::string name = "result";
+    int i = 0;
+    while (std::any_of(parameters.begin(), parameters.end(),
+                       [&name](const std::shared_ptr<Parameter> &parameter) {
+                           return parameter->getName() == name;
+                       })) {
+        name = "result" + std::to_string(i++);
     }
+    return name;
+}
 
-    std::vector<Enumerator> enumerators;
-
-    for (const clang::EnumConstantDecl *en : enumDecl->enumerators()) {
-        int64_t value = en->getInitVal().getSExtValue();
-        enumerators.emplace_back(en->getNameAsString(), value);
+std::string TreeVisitor::getShim(const clang::FunctionDecl *func,
+                                 const std::string &shimName) const {
+    clang::PrintingPolicy policy = astContext->getPrintingPolicy();
+    std::string parameters;
+    std::string arguments;
+    for (unsigned i = 0; i < func->getNumParams(); i++) {
+        std::string name = "p" + std::to_string(i);
+        clang::QualType type = func->getParamDecl(i)->getType();
+        if (i > 0) {
+            parameters += ", ";
+            arguments += ", ";
+        }
+        if (isRecordValue(type)) {
+            /* structs and unions are passed by pointer and copied
+             * when the function is called */
+            parameters += getDeclaration(
+                astContext->getPointerType(type.withConst()), name, policy);
+            arguments += "*" + name;
+        } else {
+            parameters += getDeclaration(type, name, policy);
+            arguments += name;
+        }
     }
 
-    std::string scalaType = typeTranslator.getTypeFromTypeMap(
-        enumDecl->getIntegerType().getUnqualifiedType().getAsString());
-
-    std::shared_ptr<Location> location = typeTranslator.getLocation(enumDecl);
-    if (name.empty()) {
-        name = "anonymous_" + std::to_string(anonymousEnumId++);
+    clang::QualType returnType = func->getReturnType();
+    std::string call = func->getNameAsString() + "(" + arguments + ");\n";
+    if (isRecordValue(returnType)) {
+        if (!parameters.empty()) {
+            parameters += ", ";
+        }
+        /* const struct cannot be assigned */
+        parameters += getDeclaration(
+            astContext->getPointerType(returnType.getUnqualifiedType()),
+            "result", policy);
+        call = "*result = " + call;
+        returnType = astContext->VoidTy;
+    } else if (!returnType->isVoidType()) {
+        call = "return " + call;
     }
-    std::shared_ptr<Enum> e =
-        ir.addEnum(name, scalaType, std::move(enumerators), location);
-
-    if (typedefName) {
-        /* add alias here because in VisitTypedefDecl it will be difficult to
-         * match typedef with enum */
-        ir.addTypeDef(name, e, typeTranslator.getLocation(typedefName));
+    if (parameters.empty()) {
+        parameters = "void";
     }
-
-    return true;
+    return getDeclaration(returnType, shimName + "(" + parameters + ")",
+                          policy) +
+           " {\n    " + call + "}\n";
 }
 
-bool TreeVisitor::VisitRecordDecl(clang::RecordDecl *record) {
-    std::string name = record->getNameAsString();
-
-    // Handle typedef struct {} x; and typedef union {} y; by getting the name
-    // from the typedef
-    if ((record->isStruct() || record->isUnion()) && name.empty() &&
-        record->getTypedefNameForAnonDecl()) {
-        name = record->getTypedefNameForAnonDecl()->getNameAsString();
+bool TreeVisitor::VisitTypedefDecl(clang::TypedefDecl *tpdef) {
+    if (!shouldTranslate(tpdef)) {
+        return true;
     }
+    typeTranslator.addTypeDefDefinition(tpdef);
+    return true;
+}
 
-    if (record->isUnion() && record->isThisDeclarationADefinition() &&
-        !record->isAnonymousStructOrUnion() && !name.empty()) {
-        typeTranslator.addUnionDefinition(record, name);
+bool TreeVisitor::VisitEnumDecl(clang::EnumDecl *enumDecl) {
+    if (!shouldTranslate(enumDecl)) {
         return true;
+    }
+    typeTranslator.addEnumDefinition(enumDecl);
+    return true;
+}
 
-    } else if (record->isStruct() && record->isThisDeclarationADefinition() &&
-               !record->isAnonymousStructOrUnion() && !name.empty()) {
-        typeTranslator.addStructDefinition(record, name);
+bool TreeVisitor::VisitRecordDecl(clang::RecordDecl *record) {
+    if (!shouldTranslate(record)) {
         return true;
     }
-    return false;
+    return typeTranslator.addRecordDefinition(record);
+}
+
+bool TreeVisitor::shouldTranslate(const clang::Decl *decl) const {
+    /* in lazy mode types from included headers are translated by
+     * TypeTranslator when they are referenced */
+    return !lazyTypes || typeTranslator.isInMainFile(decl);
 }
 
 bool TreeVisitor::VisitVarDecl(clang::VarDecl *varDecl) {
@@ -124,7 +215,8 @@ bool TreeVisitor::VisitVarDecl(clang::VarDecl *varDecl) {
             typeTranslator.translate(varDecl->getType());
         std::shared_ptr<Variable> variable = ir.addVariable(variableName, type);
         /* check if there is a macro for the variable.
-         * Macros were saved by DefineFinder */
+         * Macros that are defined after the variable declaration are
+         * matched by IR::addPossibleVarDefine */
         std::string macroName = ir.getDefineForVar(variableName);
         if (!macroName.empty()) {
             ir.addVarDefine(macroName, variable);
@@ -10,17 +10,71 @@ class TreeVisitor : public clang::RecursiveASTVisitor<TreeVisitor> {
     clang::ASTContext *astContext;
     TypeTranslator typeTranslator;
     IR &ir;
-    uint anonymousEnumId = 0;
+    bool lazyTypes;
+    bool generateShims;
 
-    bool isAliasForAnonymousEnum(clang::TypedefDecl *tpdef) const;
+    /**
+     * @return false if declaration of a type is from included header and
+     *         it should be translated only when it is referenced
+     */
+    bool shouldTranslate(const clang::Decl *decl) const;
+
+    /**
+     * @return true if the function is defined in the header and the
+     *         library does not export a symbol for it, for example
+     *         `static inline` function
+     */
+    bool hasNoLinkableSymbol(const clang::FunctionDecl *func) const;
+
+    /**
+     * @return true if the function takes or returns struct or union
+     *         by value
+     */
+    bool passesRecordByValue(const clang::FunctionDecl *func) const;
+
+    /**
+     * @return name of the parameter to which the wrapper writes
+     *         returned struct or union
+     */
+    std::string getResultParameterName(
+        const std::vector<std::shared_ptr<Parameter>> &parameters) const;
+
+    /**
+     * @return C definition of a function with given name that
+     *         calls func with the same arguments.
+     *         Structs and unions are passed to the wrapper by pointer,
+     *         returned struct or union is written to the last parameter
+     */
+    std::string getShim(const clang::FunctionDecl *func,
+                        const std::string &shimName) const;
 
   public:
-    TreeVisitor(clang::CompilerInstance *CI, IR &ir)
-        : astContext(&(CI->getASTContext())), typeTranslator(astContext, ir),
-          ir(ir) {}
+    /**
+     * @param lazyTypes if true then types from included headers are
+     *                  translated only when they are used by declarations
+     *                  from the main header
+     * @param generateShims if true then functions that do not have
+     *                      linkable symbol or pass structs by value are
+     *                      called through C wrappers
+     */
+    TreeVisitor(clang::CompilerInstance *CI, IR &ir, bool lazyTypes,
+                bool generateShims)
+        : astContext(&(CI->getASTContext())),
+          typeTranslator(astContext, ir, lazyTypes), ir(ir),
+          lazyTypes(lazyTypes), generateShims(generateShims) {}
 
     virtual ~TreeVisitor() = default;
 
+    /**
+     * Only declarations are translated therefore statements, expressions
+     * and type locations are never traversed.
+     */
+    bool TraverseStmt(clang::Stmt *stmt, DataRecursionQueue *queue = nullptr) {
+        return true;
+    }
+
+    bool TraverseTypeLoc(clang::TypeLoc typeLoc) { return true; }
+
     virtual bool VisitFunctionDecl(clang::FunctionDecl *func);
     virtual bool VisitTypedefDecl(clang::TypedefDecl *tpdef);
     virtual bool VisitEnumDecl(clang::EnumDecl *enumDecl);
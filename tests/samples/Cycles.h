@@ -87,4 +87,28 @@ struct FuncPointerWithValueType1 {
 struct FuncPointerWithValueType2 {
     struct FuncPointerWithValueType1 (*memberFunction)(
         void); // return type will be replaced by CStruct0
-};
\ No newline at end of file
+};
+/* field closes one cycle and continues into another */
+
+struct CloseAndContinue2;
+
+struct CloseAndContinue1 {
+    struct CloseAndContinue1 *(*memberFunction)(
+        struct CloseAndContinue2 *); // returns Ptr[Byte]
+};
+
+struct CloseAndContinue2 {
+    struct CloseAndContinue1 *s; // replaced with Ptr[Byte]
+};
+
+/* all other fields in cycle have value type */
+
+struct ValueCycle1;
+
+struct ValueCycle2 {
+    struct ValueCycle1 *s; // replaced with Ptr[Byte]
+};
+
+struct ValueCycle1 {
+    struct ValueCycle2 s;
+};
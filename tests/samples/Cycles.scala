@@ -20,6 +20,10 @@ object Cycles {
   type struct_cycleWithUnionS = native.CStruct1[native.Ptr[union_cycleWithUnionU]]
   type struct_FuncPointerWithValueType2 = native.CStruct1[native.CFunctionPtr0[native.CStruct0]]
   type struct_FuncPointerWithValueType1 = native.CStruct1[native.Ptr[struct_FuncPointerWithValueType2]]
+  type struct_CloseAndContinue2 = native.CStruct1[native.Ptr[Byte]]
+  type struct_CloseAndContinue1 = native.CStruct1[native.CFunctionPtr1[native.Ptr[struct_CloseAndContinue2], native.Ptr[Byte]]]
+  type struct_ValueCycle1 = native.CStruct1[struct_ValueCycle2]
+  type struct_ValueCycle2 = native.CStruct1[native.Ptr[Byte]]
 
   object implicits {
     implicit class struct_node_ops(val p: native.Ptr[struct_node]) extends AnyVal {
@@ -94,6 +98,26 @@ object Cycles {
       def memberFunction_=(value: native.CFunctionPtr0[struct_FuncPointerWithValueType1]): Unit = !p._1 = value.cast[native.CFunctionPtr0[native.CStruct0]]
     }
 
+    implicit class struct_CloseAndContinue1_ops(val p: native.Ptr[struct_CloseAndContinue1]) extends AnyVal {
+      def memberFunction: native.CFunctionPtr1[native.Ptr[struct_CloseAndContinue2], native.Ptr[struct_CloseAndContinue1]] = (!p._1).cast[native.CFunctionPtr1[native.Ptr[struct_CloseAndContinue2], native.Ptr[struct_CloseAndContinue1]]]
+      def memberFunction_=(value: native.CFunctionPtr1[native.Ptr[struct_CloseAndContinue2], native.Ptr[struct_CloseAndContinue1]]): Unit = !p._1 = value.cast[native.CFunctionPtr1[native.Ptr[struct_CloseAndContinue2], native.Ptr[Byte]]]
+    }
+
+    implicit class struct_CloseAndContinue2_ops(val p: native.Ptr[struct_CloseAndContinue2]) extends AnyVal {
+      def s: native.Ptr[struct_CloseAndContinue1] = (!p._1).cast[native.Ptr[struct_CloseAndContinue1]]
+      def s_=(value: native.Ptr[struct_CloseAndContinue1]): Unit = !p._1 = value.cast[native.Ptr[Byte]]
+    }
+
+    implicit class struct_ValueCycle2_ops(val p: native.Ptr[struct_ValueCycle2]) extends AnyVal {
+      def s: native.Ptr[struct_ValueCycle1] = (!p._1).cast[native.Ptr[struct_ValueCycle1]]
+      def s_=(value: native.Ptr[struct_ValueCycle1]): Unit = !p._1 = value.cast[native.Ptr[Byte]]
+    }
+
+    implicit class struct_ValueCycle1_ops(val p: native.Ptr[struct_ValueCycle1]) extends AnyVal {
+      def s: native.Ptr[struct_ValueCycle2] = p._1
+      def s_=(value: native.Ptr[struct_ValueCycle2]): Unit = !p._1 = !value
+    }
+
     implicit class union_cycleWithUnionU_pos(val p: native.Ptr[union_cycleWithUnionU]) extends AnyVal {
       def s: native.Ptr[native.Ptr[struct_cycleWithUnionS]] = p.cast[native.Ptr[native.Ptr[struct_cycleWithUnionS]]]
       def s_=(value: native.Ptr[struct_cycleWithUnionS]): Unit = !p.cast[native.Ptr[native.Ptr[struct_cycleWithUnionS]]] = value
@@ -240,4 +264,44 @@ object Cycles {
       ptr
     }
   }
+
+  object struct_CloseAndContinue1 {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_CloseAndContinue1] = native.alloc[struct_CloseAndContinue1]
+    def apply(memberFunction: native.CFunctionPtr1[native.Ptr[struct_CloseAndContinue2], native.Ptr[struct_CloseAndContinue1]])(implicit z: native.Zone): native.Ptr[struct_CloseAndContinue1] = {
+      val ptr = native.alloc[struct_CloseAndContinue1]
+      ptr.memberFunction = memberFunction
+      ptr
+    }
+  }
+
+  object struct_CloseAndContinue2 {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_CloseAndContinue2] = native.alloc[struct_CloseAndContinue2]
+    def apply(s: native.Ptr[struct_CloseAndContinue1])(implicit z: native.Zone): native.Ptr[struct_CloseAndContinue2] = {
+      val ptr = native.alloc[struct_CloseAndContinue2]
+      ptr.s = s
+      ptr
+    }
+  }
+
+  object struct_ValueCycle2 {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_ValueCycle2] = native.alloc[struct_ValueCycle2]
+    def apply(s: native.Ptr[struct_ValueCycle1])(implicit z: native.Zone): native.Ptr[struct_ValueCycle2] = {
+      val ptr = native.alloc[struct_ValueCycle2]
+      ptr.s = s
+      ptr
+    }
+  }
+
+  object struct_ValueCycle1 {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_ValueCycle1] = native.alloc[struct_ValueCycle1]
+    def apply(s: native.Ptr[struct_ValueCycle2])(implicit z: native.Zone): native.Ptr[struct_ValueCycle1] = {
+      val ptr = native.alloc[struct_ValueCycle1]
+      ptr.s = s
+      ptr
+    }
+  }
 }
@@ -0,0 +1,16 @@
+struct packet {
+    unsigned char vl;
+    long length;
+};
+
+#define HDR_SIZE 20
+
+#define HDR_LEN(h) (((h)->vl & 0x0f) << 2)
+#define PACKET_END(p) ((p)->length + HDR_SIZE)
+#define ALIGN_UP(x, a) (((x) + (a)-1) & ~((a)-1))
+#define IS_POWER_OF_TWO(x) (((x) & ((x)-1)) == 0)
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define IN_RANGE(x, low, high) ((x) >= (low) && (x) <= (high))
+
+#define CALL(x) foo(x)              // skipped
+#define UNSIGNED_MASK(x) ((x)&0xffu) // skipped
@@ -0,0 +1,39 @@
+package org.scalanative.bindgen.samples
+
+import scala.scalanative._
+import scala.scalanative.native._
+
+object FunctionDefine {
+  type struct_packet = native.CStruct2[native.CUnsignedChar, native.CLong]
+
+  object defines {
+    import implicits._
+    val HDR_SIZE: native.CInt = 20
+    @inline def HDR_LEN(h: native.Ptr[struct_packet]): native.CInt = (h.vl.toInt & 15) << 2
+    @inline def PACKET_END(p: native.Ptr[struct_packet]): native.CLong = p.length + 20
+    @inline def ALIGN_UP(x: native.CLong, a: native.CLong): native.CLong = ((x + a) - 1) & (~(a - 1))
+    @inline def IS_POWER_OF_TWO(x: native.CLong): native.CBool = (x & (x - 1)) == 0
+    @inline def MAX(a: native.CLong, b: native.CLong): native.CLong = if (a > b) a else b
+    @inline def IN_RANGE(x: native.CLong, low: native.CLong, high: native.CLong): native.CBool = (x >= low) && (x <= high)
+  }
+
+  object implicits {
+    implicit class struct_packet_ops(val p: native.Ptr[struct_packet]) extends AnyVal {
+      def vl: native.CUnsignedChar = !p._1
+      def vl_=(value: native.CUnsignedChar): Unit = !p._1 = value
+      def length: native.CLong = !p._2
+      def length_=(value: native.CLong): Unit = !p._2 = value
+    }
+  }
+
+  object struct_packet {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_packet] = native.alloc[struct_packet]
+    def apply(vl: native.CUnsignedChar, length: native.CLong)(implicit z: native.Zone): native.Ptr[struct_packet] = {
+      val ptr = native.alloc[struct_packet]
+      ptr.vl = vl
+      ptr.length = length
+      ptr
+    }
+  }
+}
@@ -50,3 +50,20 @@
 #define HEXADECIMAL_WITHOUT_RADIX 0x1ffp10
 #define HEXADECIMAL_WITH_RADIX 0xf.p-1
 #define HEXADECIMAL_FRACTIONAL_WITH_RADIX 0x0.123p-1
+
+// macro that is defined after it was expanded
+#define EXPANDS_TO_DEFINED_LATER DEFINED_LATER
+#define EXPANDED_BEFORE_DEFINITION EXPANDS_TO_DEFINED_LATER // excluded
+#define DEFINED_LATER 5
+#define EXPANDED_AFTER_DEFINITION EXPANDS_TO_DEFINED_LATER // 5
+
+// constant expressions
+#define FLAG_A 0x1
+#define FLAG_B 0x2
+#define SHIFTED_FLAG (1u << 4)
+#define FLAGS (FLAG_A | FLAG_B)
+#define CAST_INT ((int)0x7f)
+#define SIZE_OF_INT sizeof(int)
+#define MAXIMUM_UNSIGNED_INT (~0u)
+#define HALF (1.0 / 2)
+#define NOT_CONSTANT (not_declared + 1) // excluded
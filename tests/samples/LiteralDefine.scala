@@ -25,5 +25,15 @@ object LiteralDefine {
     val HEXADECIMAL_WITHOUT_RADIX: native.CDouble = 523264
     val HEXADECIMAL_WITH_RADIX: native.CDouble = 7.5
     val HEXADECIMAL_FRACTIONAL_WITH_RADIX: native.CDouble = 0.0355225
+    val DEFINED_LATER: native.CInt = 5
+    val EXPANDED_AFTER_DEFINITION: native.CInt = 5
+    val FLAG_A: native.CInt = 1
+    val FLAG_B: native.CInt = 2
+    val SHIFTED_FLAG: native.CUnsignedInt = 16.toUInt
+    val FLAGS: native.CInt = 3
+    val CAST_INT: native.CInt = 127
+    val SIZE_OF_INT: native.CUnsignedLong = 4L.toULong
+    val MAXIMUM_UNSIGNED_INT: native.CUnsignedInt = (-1).toUInt
+    val HALF: native.CDouble = 0.5
   }
 }
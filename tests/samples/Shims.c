@@ -0,0 +1,17 @@
+#include "Shims.h"
+
+struct vec makeVec(int x, int y) {
+    struct vec v = {x, y};
+    return v;
+}
+
+int dot(struct vec a, struct vec b) { return a.x * b.x + a.y * b.y; }
+
+const struct vec scaleVec(struct vec v, int factor) {
+    return makeVec(v.x * factor, v.y * factor);
+}
+
+void negate(struct vec *v) {
+    v->x = -v->x;
+    v->y = -v->y;
+}
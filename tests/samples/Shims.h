@@ -0,0 +1,14 @@
+struct vec {
+    int x;
+    int y;
+};
+
+static inline int add(int a, int b) { return a + b; }
+
+struct vec makeVec(int x, int y);
+
+int dot(struct vec a, struct vec b);
+
+const struct vec scaleVec(struct vec v, int factor);
+
+void negate(struct vec *v); // linked without wrapper
@@ -0,0 +1,40 @@
+package org.scalanative.bindgen.samples
+
+import scala.scalanative._
+import scala.scalanative.native._
+
+@native.link("bindgentests")
+@native.extern
+object Shims {
+  type struct_vec = native.CStruct2[native.CInt, native.CInt]
+  @native.link("scala_native_bindgen_add")
+  def add(a: native.CInt, b: native.CInt): native.CInt = native.extern
+  @native.link("scala_native_bindgen_makeVec")
+  def makeVec(x: native.CInt, y: native.CInt, result: native.Ptr[struct_vec]): Unit = native.extern
+  @native.link("scala_native_bindgen_dot")
+  def dot(a: native.Ptr[struct_vec], b: native.Ptr[struct_vec]): native.CInt = native.extern
+  @native.link("scala_native_bindgen_scaleVec")
+  def scaleVec(v: native.Ptr[struct_vec], factor: native.CInt, result: native.Ptr[struct_vec]): Unit = native.extern
+  def negate(v: native.Ptr[struct_vec]): Unit = native.extern
+
+  object implicits {
+    implicit class struct_vec_ops(val p: native.Ptr[struct_vec]) extends AnyVal {
+      def x: native.CInt = !p._1
+      def x_=(value: native.CInt): Unit = !p._1 = value
+      def y: native.CInt = !p._2
+      def y_=(value: native.CInt): Unit = !p._2 = value
+    }
+  }
+
+  object struct_vec {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_vec] = native.alloc[struct_vec]
+    def apply(x: native.CInt, y: native.CInt)(implicit z: native.Zone): native.Ptr[struct_vec] = {
+      val ptr = native.alloc[struct_vec]
+      ptr.x = x
+      ptr.y = y
+      ptr
+    }
+  }
+}
+
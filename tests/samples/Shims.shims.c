@@ -0,0 +1,19 @@
+/* Generated by scala-native-bindgen. Wrappers of functions that do not
+ * have linkable symbol or pass structs and unions by value. */
+#include "Shims.h"
+
+int scala_native_bindgen_add(int p0, int p1) {
+    return add(p0, p1);
+}
+
+void scala_native_bindgen_makeVec(int p0, int p1, struct vec *result) {
+    *result = makeVec(p0, p1);
+}
+
+int scala_native_bindgen_dot(const struct vec *p0, const struct vec *p1) {
+    return dot(*p0, *p1);
+}
+
+void scala_native_bindgen_scaleVec(const struct vec *p0, int p1, struct vec *result) {
+    *result = scaleVec(*p0, p1);
+}
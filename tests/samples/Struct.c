@@ -68,3 +68,31 @@ int struct_test_point(struct bigStruct *s, enum struct_op op,
         return (s->six.x == value->x) && (s->six.y == value->y);
     }
 }
+
+void setBitFieldSigned(struct bitFieldSigned *s, int small, long wide) {
+    s->small = small;
+    s->wide = wide;
+}
+
+int getBitFieldSignedSmall(struct bitFieldSigned *s) { return s->small; }
+
+long getBitFieldSignedWide(struct bitFieldSigned *s) { return s->wide; }
+
+unsigned long getBitFieldSignedHighLong(struct bitFieldSigned *s) {
+    return s->highLong;
+}
+
+void setPackedStruct(struct packedStruct *s, int b, unsigned short flags,
+                     long d) {
+    s->b = b;
+    s->flags = flags;
+    s->d = d;
+}
+
+int getPackedStructB(struct packedStruct *s) { return s->b; }
+
+unsigned short getPackedStructFlags(struct packedStruct *s) {
+    return s->flags;
+}
+
+long getPackedStructD(struct packedStruct *s) { return s->d; }
@@ -56,23 +56,38 @@ struct structWithAnonymousStruct {
     } anonymousStruct;
 };
 
-struct __attribute__((__packed__)) packedStruct { // no helper methods
+struct __attribute__((__packed__)) packedStruct {
     char a;
+    int b;
+    struct point c;
+    unsigned char small : 3;
+    unsigned short flags : 12;
+    long d;
 };
 
-struct bitFieldStruct { // no helper methods
+struct bitFieldStruct {
     unsigned char b1 : 3;
     unsigned char : 0; // start a new byte
     unsigned char b2 : 6;
     unsigned char b3 : 2;
 };
 
-struct bitFieldOffsetDivByEight { // no helper methods
+struct bitFieldOffsetDivByEight {
     unsigned b1 : 8;
     unsigned b2 : 8;
     unsigned char b3 : 8;
 };
 
+struct bitFieldSigned {
+    int flag : 1;
+    int small : 5;
+    long wide : 40; // shares 64-bit storage with previous fields
+    _Bool b : 1;
+    int ordinary;
+    unsigned high : 32;
+    unsigned long highLong : 32; // stored in 32-bit integer
+};
+
 char getCharFromAnonymousStruct(struct structWithAnonymousStruct *s);
 
 char getIntFromAnonymousStruct(struct structWithAnonymousStruct *s);
@@ -83,3 +98,14 @@ int struct_test_long(struct bigStruct *s, enum struct_op op, long value);
 int struct_test_double(struct bigStruct *s, enum struct_op op, double value);
 int struct_test_point(struct bigStruct *s, enum struct_op op,
                       struct point *value);
+
+void setBitFieldSigned(struct bitFieldSigned *s, int small, long wide);
+int getBitFieldSignedSmall(struct bitFieldSigned *s);
+long getBitFieldSignedWide(struct bitFieldSigned *s);
+unsigned long getBitFieldSignedHighLong(struct bitFieldSigned *s);
+
+void setPackedStruct(struct packedStruct *s, int b, unsigned short flags,
+                     long d);
+int getPackedStructB(struct packedStruct *s);
+unsigned short getPackedStructFlags(struct packedStruct *s);
+long getPackedStructD(struct packedStruct *s);
@@ -27,9 +27,10 @@ object Struct {
   type struct_bigStruct = native.CArray[Byte, native.Nat.Digit[native.Nat._1, native.Nat.Digit[native.Nat._1, native.Nat._2]]]
   type struct_anonymous_0 = native.CStruct2[native.CChar, native.CInt]
   type struct_structWithAnonymousStruct = native.CStruct2[native.CInt, struct_anonymous_0]
-  type struct_packedStruct = native.CStruct1[native.CChar]
+  type struct_packedStruct = native.CArray[Byte, native.Nat.Digit[native.Nat._2, native.Nat._3]]
   type struct_bitFieldStruct = native.CArray[Byte, native.Nat._2]
   type struct_bitFieldOffsetDivByEight = native.CArray[Byte, native.Nat._4]
+  type struct_bitFieldSigned = native.CArray[Byte, native.Nat.Digit[native.Nat._2, native.Nat._4]]
   def setPoints(points: native.Ptr[struct_points], x1: native.CInt, y1: native.CInt, x2: native.CInt, y2: native.CInt): Unit = native.extern
   def getPoint(points: native.Ptr[struct_points], pointIndex: enum_pointIndex): native.CInt = native.extern
   def createPoint(): native.Ptr[struct_point] = native.extern
@@ -39,6 +40,14 @@ object Struct {
   def struct_test_long(s: native.Ptr[struct_bigStruct], op: enum_struct_op, value: native.CLong): native.CInt = native.extern
   def struct_test_double(s: native.Ptr[struct_bigStruct], op: enum_struct_op, value: native.CDouble): native.CInt = native.extern
   def struct_test_point(s: native.Ptr[struct_bigStruct], op: enum_struct_op, value: native.Ptr[struct_point]): native.CInt = native.extern
+  def setBitFieldSigned(s: native.Ptr[struct_bitFieldSigned], small: native.CInt, wide: native.CLong): Unit = native.extern
+  def getBitFieldSignedSmall(s: native.Ptr[struct_bitFieldSigned]): native.CInt = native.extern
+  def getBitFieldSignedWide(s: native.Ptr[struct_bitFieldSigned]): native.CLong = native.extern
+  def getBitFieldSignedHighLong(s: native.Ptr[struct_bitFieldSigned]): native.CUnsignedLong = native.extern
+  def setPackedStruct(s: native.Ptr[struct_packedStruct], b: native.CInt, flags: native.CUnsignedShort, d: native.CLong): Unit = native.extern
+  def getPackedStructB(s: native.Ptr[struct_packedStruct]): native.CInt = native.extern
+  def getPackedStructFlags(s: native.Ptr[struct_packedStruct]): native.CUnsignedShort = native.extern
+  def getPackedStructD(s: native.Ptr[struct_packedStruct]): native.CLong = native.extern
 
   object implicits {
     implicit class struct_point_ops(val p: native.Ptr[struct_point]) extends AnyVal {
@@ -117,6 +126,128 @@ object Struct {
       def anonymousStruct: native.Ptr[struct_anonymous_0] = p._2
       def anonymousStruct_=(value: native.Ptr[struct_anonymous_0]): Unit = !p._2 = !value
     }
+
+    implicit class struct_packedStruct_ops(val p: native.Ptr[struct_packedStruct]) extends AnyVal {
+      def a: native.CChar = {
+        val value = native.stackalloc[native.CChar]
+        native.string.memcpy(value.cast[native.Ptr[Byte]], p._1, native.sizeof[native.CChar])
+        !value
+      }
+      def a_=(value: native.CChar): Unit = {
+        val ptr = native.stackalloc[native.CChar]
+        !ptr = value
+        native.string.memcpy(p._1, ptr.cast[native.Ptr[Byte]], native.sizeof[native.CChar])
+      }
+      def b: native.CInt = {
+        val value = native.stackalloc[native.CInt]
+        native.string.memcpy(value.cast[native.Ptr[Byte]], (p._1 + 1), native.sizeof[native.CInt])
+        !value
+      }
+      def b_=(value: native.CInt): Unit = {
+        val ptr = native.stackalloc[native.CInt]
+        !ptr = value
+        native.string.memcpy((p._1 + 1), ptr.cast[native.Ptr[Byte]], native.sizeof[native.CInt])
+      }
+      def c: native.Ptr[struct_point] = (p._1 + 5).cast[native.Ptr[struct_point]]
+      def c_=(value: native.Ptr[struct_point]): Unit = native.string.memcpy((p._1 + 5), value.cast[native.Ptr[Byte]], native.sizeof[struct_point])
+      def small: native.CUnsignedChar = ((!(p._1 + 13).cast[native.Ptr[Byte]]).toInt & 0x7).toUByte
+      def small_=(value: native.CUnsignedChar): Unit = {
+        val ptr = (p._1 + 13).cast[native.Ptr[Byte]]
+        !ptr = (((!ptr).toInt & 0xfffffff8) | (value.toInt & 0x7)).toByte
+      }
+      def flags: native.CUnsignedShort = {
+        val ptr = native.stackalloc[native.CShort]
+        native.string.memcpy(ptr.cast[native.Ptr[Byte]], (p._1 + 13), native.sizeof[native.CShort])
+        (((!ptr).toInt >>> 3) & 0xfff).toUShort
+      }
+      def flags_=(value: native.CUnsignedShort): Unit = {
+        val ptr = native.stackalloc[native.CShort]
+        native.string.memcpy(ptr.cast[native.Ptr[Byte]], (p._1 + 13), native.sizeof[native.CShort])
+        !ptr = (((!ptr).toInt & 0xffff8007) | ((value.toInt & 0xfff) << 3)).toShort
+        native.string.memcpy((p._1 + 13), ptr.cast[native.Ptr[Byte]], native.sizeof[native.CShort])
+      }
+      def d: native.CLong = {
+        val value = native.stackalloc[native.CLong]
+        native.string.memcpy(value.cast[native.Ptr[Byte]], (p._1 + 15), native.sizeof[native.CLong])
+        !value
+      }
+      def d_=(value: native.CLong): Unit = {
+        val ptr = native.stackalloc[native.CLong]
+        !ptr = value
+        native.string.memcpy((p._1 + 15), ptr.cast[native.Ptr[Byte]], native.sizeof[native.CLong])
+      }
+    }
+
+    implicit class struct_bitFieldStruct_ops(val p: native.Ptr[struct_bitFieldStruct]) extends AnyVal {
+      def b1: native.CUnsignedChar = ((!p._1.cast[native.Ptr[Byte]]).toInt & 0x7).toUByte
+      def b1_=(value: native.CUnsignedChar): Unit = {
+        val ptr = p._1.cast[native.Ptr[Byte]]
+        !ptr = (((!ptr).toInt & 0xfffffff8) | (value.toInt & 0x7)).toByte
+      }
+      def b2: native.CUnsignedChar = ((!(p._1 + 1).cast[native.Ptr[Byte]]).toInt & 0x3f).toUByte
+      def b2_=(value: native.CUnsignedChar): Unit = {
+        val ptr = (p._1 + 1).cast[native.Ptr[Byte]]
+        !ptr = (((!ptr).toInt & 0xffffffc0) | (value.toInt & 0x3f)).toByte
+      }
+      def b3: native.CUnsignedChar = (((!(p._1 + 1).cast[native.Ptr[Byte]]).toInt >>> 6) & 0x3).toUByte
+      def b3_=(value: native.CUnsignedChar): Unit = {
+        val ptr = (p._1 + 1).cast[native.Ptr[Byte]]
+        !ptr = (((!ptr).toInt & 0xffffff3f) | ((value.toInt & 0x3) << 6)).toByte
+      }
+    }
+
+    implicit class struct_bitFieldOffsetDivByEight_ops(val p: native.Ptr[struct_bitFieldOffsetDivByEight]) extends AnyVal {
+      def b1: native.CUnsignedInt = ((!p._1.cast[native.Ptr[Byte]]).toInt & 0xff).toUInt
+      def b1_=(value: native.CUnsignedInt): Unit = {
+        val ptr = p._1.cast[native.Ptr[Byte]]
+        !ptr = value.toInt.toByte
+      }
+      def b2: native.CUnsignedInt = ((!(p._1 + 1).cast[native.Ptr[Byte]]).toInt & 0xff).toUInt
+      def b2_=(value: native.CUnsignedInt): Unit = {
+        val ptr = (p._1 + 1).cast[native.Ptr[Byte]]
+        !ptr = value.toInt.toByte
+      }
+      def b3: native.CUnsignedChar = ((!(p._1 + 2).cast[native.Ptr[Byte]]).toInt & 0xff).toUByte
+      def b3_=(value: native.CUnsignedChar): Unit = {
+        val ptr = (p._1 + 2).cast[native.Ptr[Byte]]
+        !ptr = value.toInt.toByte
+      }
+    }
+
+    implicit class struct_bitFieldSigned_ops(val p: native.Ptr[struct_bitFieldSigned]) extends AnyVal {
+      def flag: native.CInt = (((!p._1.cast[native.Ptr[Byte]]).toInt << 31) >> 31)
+      def flag_=(value: native.CInt): Unit = {
+        val ptr = p._1.cast[native.Ptr[Byte]]
+        !ptr = (((!ptr).toInt & 0xfffffffe) | (value & 0x1)).toByte
+      }
+      def small: native.CInt = (((!p._1.cast[native.Ptr[Byte]]).toInt << 26) >> 27)
+      def small_=(value: native.CInt): Unit = {
+        val ptr = p._1.cast[native.Ptr[Byte]]
+        !ptr = (((!ptr).toInt & 0xffffffc1) | ((value & 0x1f) << 1)).toByte
+      }
+      def wide: native.CLong = (((!p._1.cast[native.Ptr[native.CLong]]) << 18) >> 24)
+      def wide_=(value: native.CLong): Unit = {
+        val ptr = p._1.cast[native.Ptr[native.CLong]]
+        !ptr = ((!ptr) & 0xffffc0000000003fL) | ((value & 0xffffffffffL) << 6)
+      }
+      def b: native.CBool = (((!(p._1 + 5).cast[native.Ptr[Byte]]).toInt >>> 6) & 0x1) != 0
+      def b_=(value: native.CBool): Unit = {
+        val ptr = (p._1 + 5).cast[native.Ptr[Byte]]
+        !ptr = (((!ptr).toInt & 0xffffffbf) | ((if (value) 1 else 0) << 6)).toByte
+      }
+      def ordinary: native.CInt = !(p._1 + 8).cast[native.Ptr[native.CInt]]
+      def ordinary_=(value: native.CInt): Unit = !(p._1 + 8).cast[native.Ptr[native.CInt]] = value
+      def high: native.CUnsignedInt = (!(p._1 + 12).cast[native.Ptr[native.CInt]]).toUInt
+      def high_=(value: native.CUnsignedInt): Unit = {
+        val ptr = (p._1 + 12).cast[native.Ptr[native.CInt]]
+        !ptr = value.toInt
+      }
+      def highLong: native.CUnsignedLong = (!(p._1 + 16).cast[native.Ptr[native.CInt]]).toUInt.toULong
+      def highLong_=(value: native.CUnsignedLong): Unit = {
+        val ptr = (p._1 + 16).cast[native.Ptr[native.CInt]]
+        !ptr = value.toInt
+      }
+    }
   }
 
   object struct_point {
@@ -194,4 +325,59 @@ object Struct {
       ptr
     }
   }
+
+  object struct_packedStruct {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_packedStruct] = native.alloc[struct_packedStruct]
+    def apply(a: native.CChar, b: native.CInt, c: native.Ptr[struct_point], small: native.CUnsignedChar, flags: native.CUnsignedShort, d: native.CLong)(implicit z: native.Zone): native.Ptr[struct_packedStruct] = {
+      val ptr = native.alloc[struct_packedStruct]
+      ptr.a = a
+      ptr.b = b
+      ptr.c = c
+      ptr.small = small
+      ptr.flags = flags
+      ptr.d = d
+      ptr
+    }
+  }
+
+  object struct_bitFieldStruct {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_bitFieldStruct] = native.alloc[struct_bitFieldStruct]
+    def apply(b1: native.CUnsignedChar, b2: native.CUnsignedChar, b3: native.CUnsignedChar)(implicit z: native.Zone): native.Ptr[struct_bitFieldStruct] = {
+      val ptr = native.alloc[struct_bitFieldStruct]
+      ptr.b1 = b1
+      ptr.b2 = b2
+      ptr.b3 = b3
+      ptr
+    }
+  }
+
+  object struct_bitFieldOffsetDivByEight {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_bitFieldOffsetDivByEight] = native.alloc[struct_bitFieldOffsetDivByEight]
+    def apply(b1: native.CUnsignedInt, b2: native.CUnsignedInt, b3: native.CUnsignedChar)(implicit z: native.Zone): native.Ptr[struct_bitFieldOffsetDivByEight] = {
+      val ptr = native.alloc[struct_bitFieldOffsetDivByEight]
+      ptr.b1 = b1
+      ptr.b2 = b2
+      ptr.b3 = b3
+      ptr
+    }
+  }
+
+  object struct_bitFieldSigned {
+    import implicits._
+    def apply()(implicit z: native.Zone): native.Ptr[struct_bitFieldSigned] = native.alloc[struct_bitFieldSigned]
+    def apply(flag: native.CInt, small: native.CInt, wide: native.CLong, b: native.CBool, ordinary: native.CInt, high: native.CUnsignedInt, highLong: native.CUnsignedLong)(implicit z: native.Zone): native.Ptr[struct_bitFieldSigned] = {
+      val ptr = native.alloc[struct_bitFieldSigned]
+      ptr.flag = flag
+      ptr.small = small
+      ptr.wide = wide
+      ptr.b = b
+      ptr.ordinary = ordinary
+      ptr.high = high
+      ptr.highLong = highLong
+      ptr
+    }
+  }
 }
@@ -0,0 +1,51 @@
+package org.scalanative.bindgen.samples
+
+import org.scalatest.FunSpec
+import scalanative.native._
+
+import org.scalanative.bindgen.samples.Shims.implicits._
+
+class ShimsSpec extends FunSpec {
+  describe("C shims") {
+    it("should call static inline functions") {
+      assert(Shims.add(2, 3) == 5)
+    }
+
+    it("should return structs through pointer") {
+      Zone { implicit zone: Zone =>
+        val vec = Shims.struct_vec()
+        Shims.makeVec(3, 4, vec)
+        assert(vec.x == 3)
+        assert(vec.y == 4)
+      }
+    }
+
+    it("should pass structs by value") {
+      Zone { implicit zone: Zone =>
+        val a = Shims.struct_vec(1, 2)
+        val b = Shims.struct_vec(3, 4)
+        assert(Shims.dot(a, b) == 11)
+        assert(a.x == 1 && b.y == 4)
+      }
+    }
+
+    it("should return const structs") {
+      Zone { implicit zone: Zone =>
+        val vec    = Shims.struct_vec(1, -2)
+        val scaled = Shims.struct_vec()
+        Shims.scaleVec(vec, 3, scaled)
+        assert(scaled.x == 3)
+        assert(scaled.y == -6)
+      }
+    }
+
+    it("should link functions without wrappers directly") {
+      Zone { implicit zone: Zone =>
+        val vec = Shims.struct_vec(5, -7)
+        Shims.negate(vec)
+        assert(vec.x == -5)
+        assert(vec.y == 7)
+      }
+    }
+  }
+}
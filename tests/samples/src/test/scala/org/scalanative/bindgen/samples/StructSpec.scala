@@ -134,5 +134,65 @@ class StructSpec extends FunSpec {
                                    pointPtr) == 1)
       }
     }
+
+    it("should provide field getters and setters for signed bit fields") {
+      Zone { implicit zone: Zone =>
+        val structPtr = alloc[Struct.struct_bitFieldSigned]
+        for (small <- Seq(-16, -1, 0, 15);
+             wide  <- Seq(-(1L << 39), -5L, 0L, (1L << 39) - 1)) {
+          Struct.setBitFieldSigned(structPtr, small, wide)
+          assert(structPtr.small == small)
+          assert(structPtr.wide == wide)
+        }
+
+        structPtr.small = -3
+        structPtr.wide = 1L << 38
+        structPtr.b = true
+        assert(Struct.getBitFieldSignedSmall(structPtr) == -3)
+        assert(Struct.getBitFieldSignedWide(structPtr) == (1L << 38))
+        assert(structPtr.b)
+      }
+    }
+
+    it("should not extend sign of unsigned long bit fields stored in Int") {
+      Zone { implicit zone: Zone =>
+        val structPtr = alloc[Struct.struct_bitFieldSigned]
+        structPtr.highLong = 0xffffffffL.toULong
+        assert(
+          Struct.getBitFieldSignedHighLong(structPtr).toLong == 0xffffffffL)
+        assert(structPtr.highLong.toLong == 0xffffffffL)
+      }
+    }
+
+    it("should not change neighbouring bit fields") {
+      Zone { implicit zone: Zone =>
+        val structPtr =
+          Struct.struct_bitFieldStruct(5.toUByte, 33.toUByte, 2.toUByte)
+        structPtr.b3 = 3.toUByte
+        assert(structPtr.b1.toInt == 5)
+        assert(structPtr.b2.toInt == 33)
+        assert(structPtr.b3.toInt == 3)
+      }
+    }
+
+    it("should access fields of packed structs at unaligned addresses") {
+      Zone { implicit zone: Zone =>
+        val buffer    = alloc[Byte](sizeof[Struct.struct_packedStruct] + 1)
+        val structPtr = (buffer + 1).cast[Ptr[Struct.struct_packedStruct]]
+        Struct.setPackedStruct(structPtr, -7, 0xabc.toUShort, Long.MinValue)
+        assert(structPtr.b == -7)
+        assert(structPtr.flags.toInt == 0xabc)
+        assert(structPtr.d == Long.MinValue)
+
+        structPtr.small = 5.toUByte
+        structPtr.b = 123456
+        structPtr.flags = 0x123.toUShort
+        structPtr.d = 42L
+        assert(structPtr.small.toInt == 5)
+        assert(Struct.getPackedStructB(structPtr) == 123456)
+        assert(Struct.getPackedStructFlags(structPtr).toInt == 0x123)
+        assert(Struct.getPackedStructD(structPtr) == 42L)
+      }
+    }
   }
 }
@@ -75,6 +75,23 @@ class BindgenReportingSpec extends FunSpec {
       )
     }
 
+    it("Skips function-like macros that are not integer expressions") {
+      assertBindgenError(
+        """struct s { unsigned int flags; };
+          |#define CALL(x) foo(x)
+          |#define CAST(x) ((int)(x))
+          |#define FLAGS(s) ((s)->flags)
+          |#define SUM(x, ...) (x + __VA_ARGS__)
+          |""".stripMargin,
+        Seq(
+          "Warning: Function-like macro CALL is skipped because it references `foo`.",
+          "Warning: Function-like macro CAST is skipped because it contains `int`.",
+          "Warning: Function-like macro FLAGS is skipped because field `flags` does not have a signed integer type.",
+          "Warning: Function-like macro SUM is skipped because it is variadic."
+        )
+      )
+    }
+
     it("Skips unused alias for opaque type") {
       assertBindgenError(
         """union undefinedUnion;
@@ -1,6 +1,7 @@
 package org.scalanative.bindgen
 
 import java.io.File
+import java.nio.file.Files
 import org.scalatest.FunSpec
 import scala.io.Source
 
@@ -25,6 +26,8 @@ class BindgenSpec extends FunSpec {
         val testName = input.getName.replace(".h", "")
         val expected = new File(inputDirectory, testName + ".scala")
         val config   = new File(inputDirectory, testName + ".json")
+        val shims    = new File(inputDirectory, testName + ".shims.c")
+        val cShims   = new File(outputDir, testName + ".shims.c")
         var options = BindingOptions(input)
           .name(testName)
           .link("bindgentests")
@@ -34,6 +37,54 @@ class BindgenSpec extends FunSpec {
         if (config.exists()) {
           options = options.bindingConfig(config)
         }
+        if (shims.exists()) {
+          options = options.cShims(cShims)
+        }
+
+        bindgen.generate(options) match {
+          case Right(binding) =>
+            assert(binding.source.trim() == contentOf(expected))
+            if (shims.exists()) {
+              assert(contentOf(cShims) == contentOf(shims))
+            }
+          case Left(errors) =>
+            fail("scala-native-bindgen failed: " + errors.mkString("\n"))
+        }
+      }
+    }
+
+    describe("binding configuration") {
+      val input    = new File(inputDirectory, "ReuseBindings.h")
+      val expected = new File(inputDirectory, "ReuseBindings.scala")
+
+      val customNames =
+        new File(inputDirectory, "include/CustomNames.h").getCanonicalPath
+
+      def customNamesEntry(path: String, objectName: String) =
+        s""""$path": {
+           |  "object": "org.scalanative.bindgen.samples.$objectName",
+           |  "names": {
+           |    "struct book": "book",
+           |    "struct page": "page",
+           |    "union weight": "weight",
+           |    "myInt": "MY_INT",
+           |    "enumWithTypedef": "EnumWithTypedef"
+           |  }
+           |}""".stripMargin
+
+      def generateWithConfig(name: String, entries: String*) = {
+        val config  = new File(outputDir, name + ".json")
+        val content = (
+          """"Struct.h": "org.scalanative.bindgen.samples.Struct"""" +: entries
+        ).mkString("{\n", ",\n", "\n}\n")
+        Files.write(config.toPath, content.getBytes("UTF-8"))
+
+        val options = BindingOptions(input)
+          .name("ReuseBindings")
+          .link("bindgentests")
+          .packageName("org.scalanative.bindgen.samples")
+          .excludePrefix("__")
+          .bindingConfig(config)
 
         bindgen.generate(options) match {
           case Right(binding) =>
@@ -42,6 +93,60 @@ class BindgenSpec extends FunSpec {
             fail("scala-native-bindgen failed: " + errors.mkString("\n"))
         }
       }
+
+      it("should match headers with glob patterns") {
+        generateWithConfig("GlobPattern",
+                           customNamesEntry("include/Custom*.h", "CustomNames"))
+      }
+
+      it("should match headers with full paths") {
+        generateWithConfig("FullPath",
+                           customNamesEntry(customNames, "CustomNames"))
+      }
+
+      it("should prefer full paths to suffixes and suffixes to globs") {
+        generateWithConfig(
+          "Precedence",
+          customNamesEntry("include/*.h", "Unused"),
+          customNamesEntry("CustomNames.h", "Unused"),
+          customNamesEntry(customNames, "CustomNames")
+        )
+        generateWithConfig(
+          "SuffixPrecedence",
+          customNamesEntry("include/*.h", "Unused"),
+          customNamesEntry("CustomNames.h", "Unused"),
+          customNamesEntry("include/CustomNames.h", "CustomNames")
+        )
+      }
+    }
+
+    it("should generate the same bindings with lazy types") {
+      val input = new File(inputDirectory, "IncludesHeader.h")
+      val options = BindingOptions(input)
+        .name("IncludesHeader")
+        .link("bindgentests")
+        .packageName("org.scalanative.bindgen.samples")
+        .excludePrefix("__")
+        .lazyTypes()
+
+      bindgen.generate(options) match {
+        case Right(binding) =>
+          val source = binding.source.trim()
+          /* used types of included headers are translated in order of
+           * first use */
+          val expected =
+            contentOf(new File(inputDirectory, "IncludesHeader.scala"))
+          def sortedLines(s: String) = s.split("\n").sorted.toSeq
+          assert(sortedLines(source) == sortedLines(expected))
+          /* struct document is used only through a pointer */
+          assert(source.contains("type struct_document ="))
+          assert(source.contains("type struct_metadata ="))
+          assert(!source.contains("unusedStruct"))
+          assert(!source.contains("unusedEnum"))
+          assert(!source.contains("union_data"))
+        case Left(errors) =>
+          fail("scala-native-bindgen failed: " + errors.mkString("\n"))
+      }
     }
   }
 }
@@ -35,6 +35,8 @@ class Bindgen(val executable: File) {
             withArgs("--extra-arg", extraArgs) ++
             withArgs("--extra-arg-before", extraArgsBefore) ++
             withArgs("--binding-config", bindingConfig.map(_.getAbsolutePath)) ++
+            (if (lazyTypes) Seq("--lazy-types") else Seq.empty) ++
+            withArgs("--c-shims", cShims.map(_.getAbsolutePath)) ++
             Seq(header.getAbsolutePath, "--")
 
         val cmd    = Seq(executable.getAbsolutePath) ++ options
@@ -42,6 +42,18 @@ sealed trait BindingOptions {
    */
   def bindingConfig(config: File): BindingOptions
 
+  /**
+   * Translate types from included headers only when they are used
+   * by declarations of the main header.
+   */
+  def lazyTypes(): BindingOptions
+
+  /**
+   * Write C wrappers of functions that do not have linkable symbol
+   * or pass structs by value to the given file.
+   */
+  def cShims(file: File): BindingOptions
+
 }
 
 object BindingOptions {
@@ -58,7 +70,9 @@ object BindingOptions {
                                          extraArgs: Seq[String] = Seq.empty,
                                          extraArgsBefore: Seq[String] =
                                            Seq.empty,
-                                         bindingConfig: Option[File] = None)
+                                         bindingConfig: Option[File] = None,
+                                         lazyTypes: Boolean = false,
+                                         cShims: Option[File] = None)
       extends BindingOptions {
 
     override def link(library: String): BindingOptions = {
@@ -97,5 +111,10 @@ object BindingOptions {
       copy(bindingConfig = Some(config))
     }
 
+    override def lazyTypes(): BindingOptions = copy(lazyTypes = true)
+
+    override def cShims(file: File): BindingOptions =
+      copy(cShims = Some(file))
+
   }
 }